@@ -0,0 +1,43 @@
+# Versions of the solvers in the result cache, see AOC_SOLVER_VERSION in utility/utility.hpp.
+# The version of a day is a hash of its source file and of the harness, so editing one day changes only its own version
+# and editing the harness changes all of them. Also included by tests/test_solver_version.cmake in script mode.
+
+set(AOC_HARNESS_DIR "${CMAKE_CURRENT_LIST_DIR}/../utility")
+
+# Hash of every file of the harness, in name order.
+function(aoc_get_harness_hash harness_dir result)
+  file(GLOB HarnessFiles "${harness_dir}/*")
+  list(SORT HarnessFiles)
+  set(Hashes "")
+  foreach(HarnessFile ${HarnessFiles})
+    file(SHA256 "${HarnessFile}" FileHash)
+    string(APPEND Hashes "${FileHash}")
+  endforeach()
+  string(SHA256 Hash "${Hashes}")
+  set(${result} "${Hash}" PARENT_SCOPE)
+endfunction()
+
+# Version of one day source, 16 hex digits.
+function(aoc_get_solver_version source harness_hash result)
+  file(SHA256 "${source}" SourceHash)
+  string(SHA256 Version "${SourceHash}${harness_hash}")
+  string(SUBSTRING "${Version}" 0 16 Version)
+  set(${result} "${Version}" PARENT_SCOPE)
+endfunction()
+
+# Defines AOC_SOLVER_VERSION in every day_<N>.cpp source of a target. CMake reruns when a hashed file changes,
+# which updates the definition of the edited day only.
+function(aoc_set_solver_versions target)
+  aoc_get_harness_hash("${AOC_HARNESS_DIR}" HarnessHash)
+  file(GLOB HarnessFiles "${AOC_HARNESS_DIR}/*")
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${HarnessFiles})
+
+  get_target_property(Sources ${target} SOURCES)
+  foreach(Source ${Sources})
+    if(Source MATCHES "/day_[0-9]+\\.cpp$")
+      aoc_get_solver_version("${Source}" "${HarnessHash}" Version)
+      set_property(SOURCE "${Source}" APPEND PROPERTY COMPILE_DEFINITIONS "AOC_SOLVER_VERSION=\"${Version}\"")
+      set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${Source}")
+    endif()
+  endforeach()
+endfunction()
\ No newline at end of file
@@ -1,41 +1,101 @@
 #include "utility.hpp"
+#include <array>
 
-size_t solve_part_1(const std::vector<int64_t>& values)
+namespace day_1
 {
-    size_t result = 0;
-    for (size_t i = 1; i < values.size(); i++)
+
+    size_t solve_part_1(const std::vector<int64_t>& values)
     {
-        if (values[i - 1] < values[i])
+        size_t result = 0;
+        for (size_t i = 1; i < values.size(); i++)
         {
-            ++result;
+            if (values[i - 1] < values[i])
+            {
+                ++result;
+            }
         }
-    }
 
-    return result;
-}
+        return result;
+    }
 
-int64_t solve_part_2(const std::vector<int64_t>& values)
-{
-    size_t result = 0;
-    for (size_t i = 1; i < values.size() - 2; i++)
+    int64_t solve_part_2(const std::vector<int64_t>& values)
     {
-        const auto prevSum = values[i - 1] + values[i] + values[i + 1];
-        const auto curSum = values[i] + values[i + 1] + values[i + 2];
+        size_t result = 0;
+        for (size_t i = 1; i < values.size() - 2; i++)
+        {
+            const auto prevSum = values[i - 1] + values[i] + values[i + 1];
+            const auto curSum = values[i] + values[i + 1] + values[i + 2];
+
+            if (prevSum < curSum)
+            {
+                ++result;
+            }
+        }
+
+        return result;
+    }
 
-        if (prevSum < curSum)
+    // Streaming
+    int64_t parse_value(std::string_view line)
+    {
+        int64_t value = 0;
+        auto result = std::from_chars(line.data(), line.data() + line.size(), value);
+        if (result.ec != std::errc())
         {
-            ++result;
+            throw aoc::puzzle_exception("Invalid value: " + std::string(line));
         }
+        return value;
     }
 
-    return result;
-}
+    size_t stream_part_1(aoc::line_stream& stream)
+    {
+        size_t result = 0;
+        std::optional<int64_t> previous;
+        stream.for_each_line([&](std::string_view line)
+        {
+            const auto value = parse_value(line);
+            if (previous && *previous < value)
+            {
+                ++result;
+            }
+            previous = value;
+        });
 
-int main()
-{
-    aoc::solve_puzzles(
-        aoc::read_input<1, int64_t>(true),
+        return result;
+    }
+
+    int64_t stream_part_2(aoc::line_stream& stream)
+    {
+        // Consecutive windows share two values, so comparing their sums compares the values entering and leaving.
+        size_t result = 0;
+        std::array<int64_t, 3> window = {};
+        size_t count = 0;
+        stream.for_each_line([&](std::string_view line)
+        {
+            const auto value = parse_value(line);
+            auto& leaving_value = window[count % window.size()];
+            if (count >= window.size() && leaving_value < value)
+            {
+                ++result;
+            }
+            leaving_value = value;
+            ++count;
+        });
+
+        return result;
+    }
+
+    const bool registered = aoc::register_puzzle<1, int64_t>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{ .skip_empty_lines = true },
         solve_part_1,
         solve_part_2
     );
+
+    const bool registered_streaming = aoc::register_streaming_parts<1>(
+        aoc::input_format{ .skip_empty_lines = true },
+        stream_part_1,
+        stream_part_2
+    );
+
 }
\ No newline at end of file
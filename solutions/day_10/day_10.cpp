@@ -1,130 +1,190 @@
 #include "utility.hpp"
 #include <variant>
 #include <type_traits>
+#include <string_view>
+#include <optional>
 
-struct SyntaxValidationComplete {};
-struct SyntaxValidationIncomplete
+namespace day_10
 {
-    std::vector<char> token_stack;
-};
-struct SyntaxValidationCorrupt
-{
-    char token;
-};
 
-using SyntaxValidationResult = std::variant<
-    SyntaxValidationComplete,
-    SyntaxValidationIncomplete,
-    SyntaxValidationCorrupt>;
+    struct SyntaxValidationComplete {};
+    struct SyntaxValidationIncomplete
+    {
+        std::vector<char> token_stack;
+    };
+    struct SyntaxValidationCorrupt
+    {
+        char token;
+    };
 
-SyntaxValidationResult validate_syntax(const std::string& sequence)
-{
-    std::vector<char> token_stack;
-    for(const auto token : sequence)
+    using SyntaxValidationResult = std::variant<
+        SyntaxValidationComplete,
+        SyntaxValidationIncomplete,
+        SyntaxValidationCorrupt>;
+
+    SyntaxValidationResult validate_syntax(std::string_view sequence)
     {
-        switch (token)
-        {
-        case '(': token_stack.push_back(')'); break;
-        case '[': token_stack.push_back(']'); break;
-        case '{': token_stack.push_back('}'); break;
-        case '<': token_stack.push_back('>'); break;
-        case ')': 
-        case ']': 
-        case '}': 
-        case '>':
+        std::vector<char> token_stack;
+        for(const auto token : sequence)
         {
-            if(token_stack.back() != token)
+            switch (token)
             {
-                return SyntaxValidationCorrupt{ token };
+            case '(': token_stack.push_back(')'); break;
+            case '[': token_stack.push_back(']'); break;
+            case '{': token_stack.push_back('}'); break;
+            case '<': token_stack.push_back('>'); break;
+            case ')': 
+            case ']': 
+            case '}': 
+            case '>':
+            {
+                if(token_stack.back() != token)
+                {
+                    return SyntaxValidationCorrupt{ token };
+                }
+                token_stack.pop_back();
+            } break;
+            default: break;
             }
-            token_stack.pop_back();
-        } break;
-        default: break;
         }
-    }
 
-    if(!token_stack.empty())
-    {
-        return SyntaxValidationIncomplete{ std::move(token_stack) };
-    }
+        if(!token_stack.empty())
+        {
+            return SyntaxValidationIncomplete{ std::move(token_stack) };
+        }
 
-    return SyntaxValidationComplete{ };
-}
+        return SyntaxValidationComplete{ };
+    }
 
-size_t get_illegal_token_score(const char token)
-{
-    switch(token)
+    size_t get_illegal_token_score(const char token)
     {
-	    case ')': return 3;
-	    case ']': return 57;
-	    case '}': return 1197;
-	    case '>': return 25137;
-	    default: break;
+        switch(token)
+        {
+    	    case ')': return 3;
+    	    case ']': return 57;
+    	    case '}': return 1197;
+    	    case '>': return 25137;
+    	    default: break;
+        }
+        return 0;
     }
-    return 0;
-}
 
-size_t get_autocomplete_token_score(const char token)
-{
-    switch (token)
+    size_t get_autocomplete_token_score(const char token)
     {
-	    case ')': return 1;
-	    case ']': return 2;
-	    case '}': return 3;
-	    case '>': return 4;
-	    default: break;
+        switch (token)
+        {
+    	    case ')': return 1;
+    	    case ']': return 2;
+    	    case '}': return 3;
+    	    case '>': return 4;
+    	    default: break;
+        }
+        return 0;
     }
-    return 0;
-}
 
-size_t solve_part_1(const std::vector<std::string>& values)
-{
-    size_t total_illegal_score = 0;
-    for (const auto& value : values)
+    size_t get_line_illegal_score(std::string_view value)
     {
+        size_t illegal_score = 0;
         const auto validation_result = validate_syntax(value);
         std::visit([&](const auto& result)
             {
                 if constexpr (std::is_same_v<decltype(result), const SyntaxValidationCorrupt&> == true)
                 {
-                    total_illegal_score += get_illegal_token_score(result.token);
+                    illegal_score = get_illegal_token_score(result.token);
                 }
             }, validation_result);
+        return illegal_score;
     }
-    return total_illegal_score;
-}
 
-size_t solve_part_2(const std::vector<std::string>& values)
-{
-    std::vector<size_t> autocomplete_scores;
-    for (const auto& value : values)
+    std::optional<size_t> get_line_autocomplete_score(std::string_view value)
     {
+        std::optional<size_t> autocomplete_score;
         const auto validation_result = validate_syntax(value);
         std::visit([&](const auto& result)
             {
                 if constexpr (std::is_same_v<decltype(result), const SyntaxValidationIncomplete&> == true)
                 {
-                    size_t autocomplete_score = 0;
+                    size_t score = 0;
                     for(auto it = result.token_stack.rbegin(); it != result.token_stack.rend(); it++)
                     {
                         const auto token = *it;
-                        autocomplete_score = (autocomplete_score * 5) + get_autocomplete_token_score(token);
+                        score = (score * 5) + get_autocomplete_token_score(token);
                     }
 
-                    autocomplete_scores.push_back(autocomplete_score);
+                    autocomplete_score = score;
                 }
             }, validation_result);
+        return autocomplete_score;
+    }
+
+    size_t get_middle_score(std::vector<size_t>& autocomplete_scores)
+    {
+        std::sort(autocomplete_scores.begin(), autocomplete_scores.end());
+
+        return autocomplete_scores[autocomplete_scores.size() / 2];
+    }
+
+    size_t solve_part_1(const std::vector<std::string_view>& values)
+    {
+        size_t total_illegal_score = 0;
+        for (const auto& value : values)
+        {
+            total_illegal_score += get_line_illegal_score(value);
+        }
+        return total_illegal_score;
     }
 
-    std::sort(autocomplete_scores.begin(), autocomplete_scores.end());
+    size_t solve_part_2(const std::vector<std::string_view>& values)
+    {
+        std::vector<size_t> autocomplete_scores;
+        for (const auto& value : values)
+        {
+            if (const auto autocomplete_score = get_line_autocomplete_score(value))
+            {
+                autocomplete_scores.push_back(*autocomplete_score);
+            }
+        }
 
-    return autocomplete_scores[autocomplete_scores.size() / 2];
-}
+        return get_middle_score(autocomplete_scores);
+    }
 
-int main() {
-    aoc::solve_puzzles(
-        aoc::read_input<10, std::string>(),
+    // Streaming
+    size_t stream_part_1(aoc::line_stream& stream)
+    {
+        size_t total_illegal_score = 0;
+        stream.for_each_line([&](std::string_view line)
+        {
+            total_illegal_score += get_line_illegal_score(line);
+        });
+        return total_illegal_score;
+    }
+
+    size_t stream_part_2(aoc::line_stream& stream)
+    {
+        // Only the scores of incomplete lines are kept, one number per line.
+        std::vector<size_t> autocomplete_scores;
+        stream.for_each_line([&](std::string_view line)
+        {
+            if (const auto autocomplete_score = get_line_autocomplete_score(line))
+            {
+                autocomplete_scores.push_back(*autocomplete_score);
+            }
+        });
+
+        return get_middle_score(autocomplete_scores);
+    }
+
+    const bool registered = aoc::register_puzzle<10, std::string_view>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
         solve_part_1,
         solve_part_2
     );
+
+    const bool registered_streaming = aoc::register_streaming_parts<10>(
+        aoc::input_format{},
+        stream_part_1,
+        stream_part_2
+    );
+
 }
\ No newline at end of file
@@ -1,183 +1,204 @@
 #include "utility.hpp"
-#include <array>
+#include "halo_array2.hpp"
+#include "parallel.hpp"
+#include <memory_resource>
 
-struct Octopus
+namespace day_11
 {
-    int32_t energy;
-};
 
-struct Vector
-{
-    int32_t x;
-    int32_t y;
-
-    Vector operator +(const Vector& rhs) const
-    {
-        return Vector{ x + rhs.x, y + rhs.y };
-    }
-};
-
-using OctopusDataRow = std::vector<Octopus>;
-using OctopusData = std::vector<OctopusDataRow>;
-
-struct OctopusMap
-{
-    Vector size;
-    OctopusData data;
-};
-
-
-OctopusMap parse_input(const std::vector<std::string>& values)
-{
-    if(values.empty())
+    struct Octopus
     {
-        throw aoc::puzzle_exception("Input is empty.");
-    }
-
-    const auto dimensions = Vector{
-        static_cast<int32_t>(values.front().size()),
-		static_cast<int32_t>(values.size())
+        int32_t energy;
     };
 
-    OctopusMap map{ dimensions, {} };
-    map.data.reserve(values.size());
+    using OctopusMap = aoc::HaloArray2<Octopus>;
 
-    for(const auto& value : values)
+    OctopusMap parse_input(const std::vector<std::string>& values)
     {
-        auto& row = *map.data.insert(map.data.end(), OctopusDataRow{});
-        for(const auto number : value)
+        AOC_TRACE_SCOPE("parse_input");
+
+        if(values.empty() || values.front().empty())
         {
-            row.push_back(Octopus{ static_cast<int32_t>(number - '0') });
+            throw aoc::puzzle_exception("Input is empty.");
         }
-    }
 
-    return map;
-}
+        auto map = aoc::make_halo_array2<Octopus>(aoc::Vector2s{ values.front().size(), values.size() }, 1, Octopus{ 0 });
 
-bool is_inside_map(const OctopusMap& map, Vector point)
-{
-    return point.x >= 0 && point.y >= 0 && point.x < map.size.x && point.y < map.size.y;
-}
+        for(size_t y = 0; y < values.size(); y++)
+        {
+            if(values[y].size() != map.size.x)
+            {
+                throw aoc::puzzle_exception("Invalid width of row. ");
+            }
 
-size_t simulate_step(OctopusMap& map)
-{
-    static const std::array adjacent_offsets = {
-        Vector{ -1, -1 }, Vector{ 0, -1 }, Vector{ 1, -1 },
-        Vector{ -1, 0 }, Vector{ 1, 0 },
-        Vector{ -1, 1 }, Vector{ 0, 1 }, Vector{ 1, 1 }
-    };
+            auto row = map.row(y);
+            for(size_t x = 0; x < row.size(); x++)
+            {
+                row[x] = Octopus{ static_cast<int32_t>(values[y][x] - '0') };
+            }
+        }
 
-    std::vector<std::vector<bool>> flash_map(map.size.y);
-    for(auto& flash_map_row : flash_map)
-    {
-        flash_map_row.resize(map.size.x, false);
+        return map;
     }
 
-    size_t total_flash_count = 0;
-    std::vector<Vector> flashes;
-
-    for(int32_t y = 0; y < map.size.y; y++)
+    OctopusMap load_binary_input(const aoc::Array2View<const uint8_t>& grid)
     {
-        for (int32_t x = 0; x < map.size.x; x++)
+        AOC_TRACE_SCOPE("load_binary_input");
+
+        auto map = aoc::make_halo_array2<Octopus>(grid.size, 1, Octopus{ 0 });
+        for (size_t y = 0; y < grid.size.y; y++)
         {
-            auto& octopus = map.data[y][x];
-            if(++octopus.energy > 9)
+            const auto source = grid.row(y);
+            auto row = map.row(y);
+            for (size_t x = 0; x < row.size(); x++)
             {
-                ++total_flash_count;
-                octopus.energy = 0;
-                flashes.push_back(Vector{ x, y });
+                row[x] = Octopus{ static_cast<int32_t>(source[x]) };
             }
         }
+        return map;
+    }
+
+    std::vector<size_t> append_indices(std::vector<size_t> lhs, std::vector<size_t> rhs)
+    {
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
     }
 
-    while(!flashes.empty())
+    // State of the flash propagation, allocated once per part and reused by every step.
+    struct FlashBuffers
+    {
+        // The halo counts as already flashed, so flashes never spread into it.
+        aoc::HaloArray2<bool> flash_map;
+        std::pmr::vector<size_t> flashes;
+        std::pmr::vector<size_t> new_flashes;
+
+        FlashBuffers(const aoc::Vector2s size, std::pmr::memory_resource* resource) :
+            flash_map(aoc::make_halo_array2<bool>(size, 1, true)),
+            flashes(resource),
+            new_flashes(resource)
+        {}
+    };
+
+    size_t simulate_step(OctopusMap& map, FlashBuffers& buffers)
     {
-        std::vector<Vector> new_flashes;
+        AOC_TRACE_SCOPE("simulate_step");
 
-        for(const auto& flash : flashes)
+        const auto adjacent_offsets = map.get_neighbour_offsets(aoc::adjacent_offsets);
+
+        auto& flash_map = buffers.flash_map;
+        for (size_t y = 0; y < flash_map.size.y; y++)
         {
-            flash_map[flash.y][flash.x] = true;
-            map.data[flash.y][flash.x].energy = 0;
+            auto row = flash_map.row(y);
+            std::fill(row.begin(), row.end(), false);
+        }
 
-            for(const auto adjacent_offset : adjacent_offsets)
+        const auto first_flashes = aoc::parallel_reduce(size_t{ 0 }, map.size.y, std::vector<size_t>{}, [&map](const size_t row_begin, const size_t row_end)
+        {
+            std::vector<size_t> row_flashes;
+            for (size_t y = row_begin; y < row_end; y++)
             {
-                auto offset_position = flash + adjacent_offset;
-                if(!is_inside_map(map, offset_position))
+                const auto index_begin = map.get_index(0, y);
+                for (size_t index = index_begin; index < index_begin + map.size.x; index++)
                 {
-                    continue;
+                    auto& octopus = map[index];
+                    if(++octopus.energy > 9)
+                    {
+                        octopus.energy = 0;
+                        row_flashes.push_back(index);
+                    }
                 }
+            }
+            return row_flashes;
+        }, append_indices, 0, map.size.x);
 
-                if(flash_map[offset_position.y][offset_position.x])
-                {
-                    continue;
-                }
+        auto& flashes = buffers.flashes;
+        auto& new_flashes = buffers.new_flashes;
+        flashes.assign(first_flashes.begin(), first_flashes.end());
+        size_t total_flash_count = flashes.size();
+
+        while(!flashes.empty())
+        {
+            new_flashes.clear();
 
-                auto& adjacent_octopus = map.data[offset_position.y][offset_position.x];
-                if (++adjacent_octopus.energy > 9)
+            for(const auto flash : flashes)
+            {
+                flash_map[flash] = true;
+                map[flash].energy = 0;
+
+                aoc::for_each_neighbour(map, flash, adjacent_offsets, [&](const size_t adjacent_index, Octopus& adjacent_octopus)
                 {
-                    ++total_flash_count;
-                    adjacent_octopus.energy = 0;
-                    new_flashes.push_back(Vector{ offset_position.x, offset_position.y });
-                }
+                    if(flash_map[adjacent_index])
+                    {
+                        return;
+                    }
+
+                    if (++adjacent_octopus.energy > 9)
+                    {
+                        ++total_flash_count;
+                        adjacent_octopus.energy = 0;
+                        new_flashes.push_back(adjacent_index);
+                    }
+                });
             }
+
+            flashes.swap(new_flashes);
         }
 
-        flashes = new_flashes;
+        return total_flash_count;
     }
 
-    return total_flash_count;
-}
-
-size_t solve_part_1(const std::vector<std::string>& values)
-{
-    auto map = parse_input(values);
-
-    size_t total_flash_count = 0;
-    for(size_t i = 0; i < 100; i++)
+    size_t solve_part_1(OctopusMap map)
     {
-        total_flash_count += simulate_step(map);
-    }
+        FlashBuffers buffers(map.size, aoc::get_part_memory_resource());
+        size_t total_flash_count = 0;
+        for(size_t i = 0; i < 100; i++)
+        {
+            total_flash_count += simulate_step(map, buffers);
+        }
 
-    return total_flash_count;
-}
+        return total_flash_count;
+    }
 
-int32_t count_map_flashes(const OctopusMap& map)
-{
-    int32_t count = 0;
-    for (int32_t y = 0; y < map.size.y; y++)
+    int32_t count_map_flashes(const OctopusMap& map)
     {
-        for (int32_t x = 0; x < map.size.x; x++)
+        int32_t count = 0;
+        for (size_t y = 0; y < map.size.y; y++)
         {
-            if(map.data[y][x].energy == 0)
+            for (const auto& octopus : map.row(y))
             {
-                ++count;
+                if(octopus.energy == 0)
+                {
+                    ++count;
+                }
             }
         }
+        return count;
     }
-    return count;
-}
-
-size_t solve_part_2(const std::vector<std::string>& values)
-{
-    auto map = parse_input(values);
 
-    for (size_t i = 0; ; i++)
+    size_t solve_part_2(OctopusMap map)
     {
-        simulate_step(map);
-
-        if(count_map_flashes(map) == (map.size.x * map.size.y))
+        FlashBuffers buffers(map.size, aoc::get_part_memory_resource());
+        for (size_t i = 0; ; i++)
         {
-            return i + 1;
+            simulate_step(map, buffers);
+
+            if(static_cast<size_t>(count_map_flashes(map)) == (map.size.x * map.size.y))
+            {
+                return i + 1;
+            }
         }
-    }
 
-    return 0;
-}
+        return 0;
+    }
 
-int main() {
-    aoc::solve_puzzles(
-        aoc::read_input<11, std::string>(),
+    const bool registered = aoc::register_parsed_puzzle<11, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
+        parse_input,
         solve_part_1,
         solve_part_2
     );
+
+    const bool registered_binary = aoc::register_binary_input<11, std::string>(load_binary_input);
+
 }
\ No newline at end of file
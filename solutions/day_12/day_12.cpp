@@ -1,197 +1,224 @@
 #include "utility.hpp"
+#include "task_scheduler.hpp"
 #include <memory>
 #include <map>
 #include <set>
 #include <algorithm>
 #include <functional>
+#include <numeric>
 
-bool is_upper(const std::string& value)
+namespace day_12
 {
-    for (auto& c : value)
+
+    bool is_upper(const std::string& value)
     {
-        if (!std::isupper(c))
+        for (auto& c : value)
         {
-            return false;
+            if (!std::isupper(c))
+            {
+                return false;
+            }
         }
+        return true;
     }
-    return true;
-}
 
-struct Cave;
-using CavePointer = std::shared_ptr<Cave>;
-
-struct Cave
-{
-    std::string name;
-    bool is_big_cave;
-    std::vector<CavePointer> connections;
+    struct Cave;
+    using CavePointer = std::shared_ptr<Cave>;
 
-    bool is_connected(const CavePointer& other_cave)
+    struct Cave
     {
-        return std::find(connections.begin(), connections.end(), other_cave) != connections.end();
-    }
-};
+        std::string name;
+        bool is_big_cave;
+        std::vector<CavePointer> connections;
 
-struct CaveSystem
-{
-    CavePointer start_cave;
-    CavePointer end_cave;
-    std::map<std::string, CavePointer> cave_map;
+        bool is_connected(const CavePointer& other_cave)
+        {
+            return std::find(connections.begin(), connections.end(), other_cave) != connections.end();
+        }
+    };
 
-    CavePointer find_or_create_cave(std::string& name)
+    struct CaveSystem
     {
-        auto cave = find_cave(name);
-        if (!cave)
+        CavePointer start_cave;
+        CavePointer end_cave;
+        std::map<std::string, CavePointer> cave_map;
+
+        CavePointer find_or_create_cave(std::string& name)
         {
-            cave = std::make_shared<Cave>();
-            cave->name = name;
-            cave->is_big_cave = is_upper(name);
-            cave_map.insert({ name, cave });
+            auto cave = find_cave(name);
+            if (!cave)
+            {
+                cave = std::make_shared<Cave>();
+                cave->name = name;
+                cave->is_big_cave = is_upper(name);
+                cave_map.insert({ name, cave });
+            }
+            return cave;
         }
-        return cave;
-    }
 
-    CavePointer find_cave(const std::string& name)
+        CavePointer find_cave(const std::string& name)
+        {
+    	    if(auto it = cave_map.find(name); it != cave_map.end())
+    	    {
+                return it->second;
+    	    }
+            return nullptr;
+        }
+    };
+
+    CaveSystem parse_input(const std::vector<std::string>& values)
     {
-	    if(auto it = cave_map.find(name); it != cave_map.end())
-	    {
-            return it->second;
-	    }
-        return nullptr;
-    }
-};
+        AOC_TRACE_SCOPE("parse_input");
 
-CaveSystem parse_input(const std::vector<std::string>& values)
-{
-    CaveSystem cave_system;
+        CaveSystem cave_system;
 
-    for(const auto& value : values)
-    {
-    	auto pos = value.find_first_of('-');
-        auto lhs = value.substr(0, pos);
-        auto rhs = value.substr(pos + 1);
+        for(const auto& value : values)
+        {
+        	auto pos = value.find_first_of('-');
+            auto lhs = value.substr(0, pos);
+            auto rhs = value.substr(pos + 1);
 
-        auto lhs_cave = cave_system.find_or_create_cave(lhs);;
-        auto rhs_cave = cave_system.find_or_create_cave(rhs);
+            auto lhs_cave = cave_system.find_or_create_cave(lhs);;
+            auto rhs_cave = cave_system.find_or_create_cave(rhs);
+
+            if (!lhs_cave->is_connected(rhs_cave))
+            {
+                lhs_cave->connections.push_back(rhs_cave);
+            }
+
+            if (!rhs_cave->is_connected(lhs_cave))
+            {
+                rhs_cave->connections.push_back(lhs_cave);
+            }
+        }
 
-        if (!lhs_cave->is_connected(rhs_cave))
+        if (auto it = cave_system.cave_map.find("start"); it == cave_system.cave_map.end())
+        {
+            throw aoc::puzzle_exception("Failed to find start cave.");
+        }
+        else
         {
-            lhs_cave->connections.push_back(rhs_cave);
+            cave_system.start_cave = it->second;
         }
 
-        if (!rhs_cave->is_connected(lhs_cave))
+        if (auto it = cave_system.cave_map.find("end"); it == cave_system.cave_map.end())
         {
-            rhs_cave->connections.push_back(lhs_cave);
+            throw aoc::puzzle_exception("Failed to find end cave.");
+        }
+        else
+        {
+            cave_system.end_cave = it->second;
         }
-    }
 
-    if (auto it = cave_system.cave_map.find("start"); it == cave_system.cave_map.end())
-    {
-        throw aoc::puzzle_exception("Failed to find start cave.");
-    }
-    else
-    {
-        cave_system.start_cave = it->second;
+        return cave_system;
     }
 
-    if (auto it = cave_system.cave_map.find("end"); it == cave_system.cave_map.end())
-    {
-        throw aoc::puzzle_exception("Failed to find end cave.");
-    }
-    else
-    {
-        cave_system.end_cave = it->second;
-    }
+    // Paths below this depth are split into one task per connection, deeper ones are counted by the task that reached them.
+    constexpr size_t parallel_depth = 3;
 
-    return cave_system;
-}
+    using SmallCaveVisitCallback = std::function<bool(const std::pair<CavePointer, size_t>&, size_t)>;
 
-using SmallCaveVisitCallback = std::function<bool(const std::pair<CavePointer, size_t>&, size_t)>;
+    size_t find_distinct_paths(const CaveSystem& cave_system, const SmallCaveVisitCallback& small_cave_visit_callback)
+    {
+        AOC_TRACE_SCOPE("find_distinct_paths");
 
-size_t find_distinct_paths(const CaveSystem& cave_system, const SmallCaveVisitCallback& small_cave_visit_callback)
-{
-    using TraverseFunction = std::function<void(const CavePointer&, std::vector<CavePointer>, std::map<CavePointer, size_t>, const SmallCaveVisitCallback&)>;
+        using TraverseFunction = std::function<size_t(const CavePointer&, std::vector<CavePointer>, std::map<CavePointer, size_t>, const SmallCaveVisitCallback&, size_t)>;
 
-    size_t distinct_paths = 0;
-    TraverseFunction traverse;
-    traverse = [&](const CavePointer& current_cave, std::vector<CavePointer> visted_caves, std::map<CavePointer, size_t> visited_small_caves, const SmallCaveVisitCallback& small_cave_check_func)
-    {
-        auto get_max_visited_small_cave = [&]() -> size_t
+        auto& scheduler = aoc::get_task_scheduler();
+        TraverseFunction traverse;
+        traverse = [&](const CavePointer& current_cave, std::vector<CavePointer> visted_caves, std::map<CavePointer, size_t> visited_small_caves, const SmallCaveVisitCallback& small_cave_check_func, const size_t depth) -> size_t
         {
-            size_t max = 0;
-            for (const auto& visited_small_cave : visited_small_caves)
+            auto get_max_visited_small_cave = [&]() -> size_t
             {
-                if (visited_small_cave.second > max)
+                size_t max = 0;
+                for (const auto& visited_small_cave : visited_small_caves)
                 {
-                    max = visited_small_cave.second;
+                    if (visited_small_cave.second > max)
+                    {
+                        max = visited_small_cave.second;
+                    }
                 }
-            }
 
-            return max;
-        };
+                return max;
+            };
 
-        if (!current_cave->is_big_cave)
-        {
-            if (auto it = visited_small_caves.find(current_cave); it != visited_small_caves.end())
+            if (!current_cave->is_big_cave)
             {
-                if (!small_cave_check_func(*it, get_max_visited_small_cave()))
+                if (auto it = visited_small_caves.find(current_cave); it != visited_small_caves.end())
                 {
-                    return;
+                    if (!small_cave_check_func(*it, get_max_visited_small_cave()))
+                    {
+                        return 0;
+                    }
+                    ++it->second;
                 }
-                ++it->second;
+                else
+                {
+                    if (!small_cave_check_func({ current_cave, 0 }, get_max_visited_small_cave()))
+    	            {
+    	                return 0;
+    	            }
+    	            visited_small_caves.insert({ current_cave, 1 });
+    			}
             }
-            else
-            {
-                if (!small_cave_check_func({ current_cave, 0 }, get_max_visited_small_cave()))
-	            {
-	                return;
-	            }
-	            visited_small_caves.insert({ current_cave, 1 });
-			}
-        }
-        
-        visted_caves.push_back(current_cave);
 
-        if(current_cave == cave_system.end_cave)
-        {
-            ++distinct_paths;
-            return;
-        }
+            visted_caves.push_back(current_cave);
 
-        for(const auto& connection : current_cave->connections)
-        {
-            traverse(connection, visted_caves, visited_small_caves, small_cave_check_func);
-        }
-    };
+            if(current_cave == cave_system.end_cave)
+            {
+                return 1;
+            }
 
-    traverse(cave_system.start_cave, { }, { }, small_cave_visit_callback);
+            const auto& connections = current_cave->connections;
+            if (depth < parallel_depth)
+            {
+                std::vector<size_t> connection_paths(connections.size(), 0);
+                aoc::task_group group(scheduler);
+                for (size_t i = 0; i < connections.size(); i++)
+                {
+                    group.spawn([&, i]()
+                    {
+                        connection_paths[i] = traverse(connections[i], visted_caves, visited_small_caves, small_cave_check_func, depth + 1);
+                    });
+                }
+                group.sync();
+                return std::accumulate(connection_paths.begin(), connection_paths.end(), size_t{ 0 });
+            }
+
+            size_t distinct_paths = 0;
+            for(const auto& connection : connections)
+            {
+                distinct_paths += traverse(connection, visted_caves, visited_small_caves, small_cave_check_func, depth + 1);
+            }
+            return distinct_paths;
+        };
 
-    return distinct_paths;
-}
+        return traverse(cave_system.start_cave, { }, { }, small_cave_visit_callback, 0);
+    }
 
-size_t solve_part_1(const std::vector<std::string>& values)
-{
-    auto cave_system = parse_input(values);
-    return find_distinct_paths(cave_system, [](const std::pair<CavePointer, size_t>& small_cave, size_t)
+    size_t solve_part_1(const CaveSystem& cave_system)
     {
-	    return small_cave.second < 1;
-    });
-}
+        return find_distinct_paths(cave_system, [](const std::pair<CavePointer, size_t>& small_cave, size_t)
+        {
+    	    return small_cave.second < 1;
+        });
+    }
 
 
-size_t solve_part_2(const std::vector<std::string>& values)
-{
-    auto cave_system = parse_input(values);
-    return find_distinct_paths(cave_system, [](const std::pair<CavePointer, size_t>& small_cave, size_t max_small_cave_visits)
+    size_t solve_part_2(const CaveSystem& cave_system)
     {
-        return (small_cave.second < 1 || max_small_cave_visits < 2) && (small_cave.first->name != "start" || small_cave.second < 1);
-    });
-}
+        return find_distinct_paths(cave_system, [](const std::pair<CavePointer, size_t>& small_cave, size_t max_small_cave_visits)
+        {
+            return (small_cave.second < 1 || max_small_cave_visits < 2) && (small_cave.first->name != "start" || small_cave.second < 1);
+        });
+    }
 
-int main() {
-    aoc::solve_puzzles(
-        aoc::read_input<12, std::string>(),
+    const bool registered = aoc::register_parsed_puzzle<12, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
+        parse_input,
         solve_part_1,
         solve_part_2
     );
+
 }
\ No newline at end of file
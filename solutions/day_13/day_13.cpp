@@ -1,207 +1,192 @@
 #include "utility.hpp"
-#include <array>
-#include <cstdlib>
+#include "bit_array2.hpp"
+#include "tokenizer.hpp"
 
-struct Vector
+namespace day_13
 {
-    int32_t x;
-    int32_t y;
-};
 
-using PaperDataRow = std::vector<bool>;
-using PaperData = std::vector<PaperDataRow>;
+    struct Vector
+    {
+        int32_t x;
+        int32_t y;
+    };
 
-enum class FoldDirection
-{
-    Verical,
-    Horizontal
-};
+    enum class FoldDirection
+    {
+        Verical,
+        Horizontal
+    };
 
-struct FoldInstruction
-{
-    FoldDirection dirtection;
-    int32_t position;
-};
+    struct FoldInstruction
+    {
+        FoldDirection dirtection;
+        int32_t position;
+    };
 
-struct Paper
-{
-    int32_t width;
-    int32_t height;
-    PaperData data;
-    std::vector<FoldInstruction> fold_instructions;
-};
+    struct Paper
+    {
+        aoc::BitArray2 data;
+        std::vector<FoldInstruction> fold_instructions;
+    };
 
 
-Paper parse_input(const std::vector<std::string>& values)
-{
-    if (values.empty())
+    Paper parse_input(const std::vector<std::string>& values)
     {
-        throw aoc::puzzle_exception("Input is empty.");
-    }
+        AOC_TRACE_SCOPE("parse_input");
 
-    Paper paper{};
+        if (values.empty())
+        {
+            throw aoc::puzzle_exception("Input is empty.");
+        }
 
-    std::vector<Vector> dots;
+        Paper paper{};
 
-    auto it = values.begin();
-    while (it != values.end() && !it->empty())
-    {
-        const auto& row = *it;
-        const auto pos = row.find_first_of(',');
-        const auto x = std::atoi(row.substr(0, pos).c_str());
-        const auto y = std::atoi(row.substr(pos + 1).c_str());
-        dots.push_back(Vector{ x, y });
+        std::vector<Vector> dots;
+        std::vector<int64_t> numbers;
+        int32_t width = 0;
+        int32_t height = 0;
 
-        if (x + 1 > paper.width)
+        auto it = values.begin();
+        while (it != values.end() && !it->empty())
         {
-            paper.width = x + 1;
+            numbers.clear();
+            if (!aoc::parse_integers(*it, numbers) || numbers.size() != 2)
+            {
+                throw aoc::puzzle_exception("Invalid dot: " + *it);
+            }
+            const auto x = static_cast<int32_t>(numbers[0]);
+            const auto y = static_cast<int32_t>(numbers[1]);
+            dots.push_back(Vector{ x, y });
+
+            if (x + 1 > width)
+            {
+                width = x + 1;
+            }
+            if (y + 1 > height)
+            {
+                height = y + 1;
+            }
+
+            it++;
         }
-        if (y + 1 > paper.height)
+
+        paper.data = aoc::BitArray2(aoc::Vector2s{ static_cast<size_t>(width), static_cast<size_t>(height) });
+
+        for (const auto dot : dots)
         {
-            paper.height = y + 1;
+            paper.data.set(dot.x, dot.y);
         }
 
-        it++;
-    }
+        ++it;
 
-    paper.data.resize(paper.height);
-    for (auto& row : paper.data)
-    {
-        row.resize(paper.width);
-    }
+        while (it != values.end() && !it->empty())
+        {
+            const std::string_view row = *it;
+            const auto pos = row.find_first_of('=');
+            numbers.clear();
+            if (pos == std::string_view::npos || pos == 0 || !aoc::parse_integers(row.substr(pos + 1), numbers) || numbers.size() != 1)
+            {
+                throw aoc::puzzle_exception("Invalid fold instruction: " + *it);
+            }
+            const auto fold_position = static_cast<int32_t>(numbers[0]);
+            const auto fold_direction = row[pos - 1] == 'x' ? FoldDirection::Verical : FoldDirection::Horizontal;
+            paper.fold_instructions.push_back(FoldInstruction{ fold_direction, fold_position });
+            it++;
+        }
 
-    for (const auto dot : dots)
-    {
-        paper.data[dot.y][dot.x] = true;
+        return paper;
     }
 
-    ++it;
-
-    while (it != values.end() && !it->empty())
+    void fold_paper_horizonal(Paper& paper, const int32_t position)
     {
-        auto row = *it;
-        auto pos = row.find_first_of('=');
-        const auto fold_position = std::atoi(row.substr(pos + 1).c_str());
-        row = row.substr(0, pos);
-        pos = row.find_last_of(' ');
-        const auto fold_direction = row.substr(pos + 1) == "x" ? FoldDirection::Verical : FoldDirection::Horizontal;
-        paper.fold_instructions.push_back(FoldInstruction{ fold_direction, fold_position });
-        it++;
-    }
+        const auto size = paper.data.get_size();
+        const auto fold_y = static_cast<size_t>(position);
+        const auto cut_height = size.y > fold_y ? size.y - fold_y - 1 : 0;
 
-    return paper;
-}
+        if (cut_height > fold_y)
+        {
+            throw aoc::puzzle_exception("Cut is larger than remaining paper.");
+        }
 
-void fold_paper_horizonal(Paper& paper, const int32_t position)
-{
-    auto cut = PaperData(paper.data.begin() + position + 1, paper.data.end());
-    paper.data.resize(position);
-    paper.height = paper.data.size();
+        for (size_t y = 0; y < cut_height; y++)
+        {
+            paper.data.or_row(fold_y - 1 - y, paper.data.row(fold_y + 1 + y));
+        }
 
-    if (cut.size() > paper.data.size())
-    {
-        throw aoc::puzzle_exception("Cut is larger than remaining paper.");
+        paper.data.resize(aoc::Vector2s{ size.x, fold_y });
     }
 
-    for (size_t y = 0; y < cut.size(); y++)
+    void fold_paper_vertical(Paper& paper, const int32_t position)
     {
-        size_t paper_y = paper.data.size() - 1 - y;
+        const auto size = paper.data.get_size();
+        const auto fold_x = static_cast<size_t>(position);
+        const auto cut_width = size.x > fold_x ? size.x - fold_x - 1 : 0;
 
-        for (size_t x = 0; x < paper.width; x++)
+        if (cut_width > fold_x)
         {
-            if (cut[y][x])
-            {
-                paper.data[paper_y][x] = true;
-            }
+            throw aoc::puzzle_exception("Cut is larger than remaining paper.");
         }
-    }
 
-}
-
-void fold_paper_vertical(Paper& paper, const int32_t position)
-{
-    PaperData cut;
-    cut.reserve(paper.height);
+        for (size_t y = 0; y < size.y; y++)
+        {
+            paper.data.or_reversed_row(y, paper.data.row(y), fold_x + 1, cut_width, fold_x);
+        }
 
-    for (auto& row : paper.data)
-    {
-        cut.push_back(PaperDataRow{ row.begin() + position + 1, row.end() });
-        row.resize(position);
+        paper.data.resize(aoc::Vector2s{ fold_x, size.y });
     }
-    paper.width = position;
 
-    for (size_t y = 0; y < cut.size(); y++)
+    void fold_paper(Paper& paper, const FoldInstruction& fold_instruction)
     {
-        for (size_t x = 0; x < cut[y].size(); x++)
+        AOC_TRACE_SCOPE("fold_paper");
+
+        switch (fold_instruction.dirtection)
         {
-            size_t paper_x = paper.data[y].size() - 1 - x;
-            if (cut[y][x])
-            {
-                paper.data[y][paper_x] = true;
-            }
+        case FoldDirection::Horizontal: fold_paper_horizonal(paper, fold_instruction.position); break;
+        case FoldDirection::Verical: fold_paper_vertical(paper, fold_instruction.position); break;
         }
     }
-}
 
-void fold_paper(Paper& paper, const FoldInstruction& fold_instruction)
-{
-    switch (fold_instruction.dirtection)
+    size_t count_dots(const Paper& papper)
     {
-    case FoldDirection::Horizontal: fold_paper_horizonal(paper, fold_instruction.position); break;
-    case FoldDirection::Verical: fold_paper_vertical(paper, fold_instruction.position); break;
+        return papper.data.count();
     }
-}
 
-size_t count_dots(const Paper& papper)
-{
-    size_t count = 0;
-    for (const auto& row : papper.data)
+    size_t solve_part_1(Paper paper)
     {
-        for (const auto& dot : row)
+        fold_paper(paper, paper.fold_instructions[0]);
+        return count_dots(paper);
+    }
+
+    std::string print_map(const Paper& papper)
+    {
+        const auto size = papper.data.get_size();
+        std::string result;
+        for (size_t y = 0; y < size.y; y++)
         {
-            if (dot)
+            result += "\n";
+            for (size_t x = 0; x < size.x; x++)
             {
-                ++count;
+                result += (papper.data.get(x, y) ? '#' : '.');
             }
         }
+        return result;
     }
-    return count;
-}
 
-size_t solve_part_1(const std::vector<std::string>& values)
-{
-    auto paper = parse_input(values);
-    fold_paper(paper, paper.fold_instructions[0]);
-    return count_dots(paper);
-}
-
-void print_map(const Paper& papper)
-{
-    for (const auto& row : papper.data)
+    std::string solve_part_2(Paper paper)
     {
-        for (const auto& dot : row)
+        for (const auto& fold_instruction : paper.fold_instructions)
         {
-            std::cout << (dot ? '#' : '.');
+            fold_paper(paper, fold_instruction);
         }
-        std::cout << "\n";
+        return print_map(paper);
     }
-}
 
-size_t solve_part_2(const std::vector<std::string>& values)
-{
-    auto paper = parse_input(values);
-    for (const auto& fold_instruction : paper.fold_instructions)
-    {
-        fold_paper(paper, fold_instruction);
-    }
-    print_map(paper);
-    return 0;
-}
-
-int main() {
-    aoc::solve_puzzles(
-        aoc::read_input<13, std::string>(),
+    const bool registered = aoc::register_parsed_puzzle<13, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
+        parse_input,
         solve_part_1,
         solve_part_2
     );
+
 }
\ No newline at end of file
@@ -1,140 +1,169 @@
 #include "utility.hpp"
-#include "array2.hpp"
-#include <array>
+#include "halo_array2.hpp"
+#include "parallel.hpp"
 
-using namespace aoc;
-
-Array2ui8 parse_input(const std::vector<std::string>& values)
+namespace day_15
 {
-    auto new_array = aoc::make_array2<uint8_t>(Vector2s{values.front().size(), values.size()});
 
-    for(size_t y = 0; y < values.size(); y++)
+    using namespace aoc;
+
+    using RiskMap = HaloArray2<uint8_t>;
+
+    RiskMap parse_input(const std::vector<std::string>& values)
     {
-        for (size_t x = 0; x < values[y].size(); x++)
+        AOC_TRACE_SCOPE("parse_input");
+
+        if(values.empty() || values.front().empty())
         {
-            new_array.data[y][x] = static_cast<uint8_t>(values[y][x] - '0');
+            throw aoc::puzzle_exception("Input is empty.");
         }
-    }
 
-    return new_array;
-}
+        auto new_array = aoc::make_halo_array2<uint8_t>(Vector2s{values.front().size(), values.size()}, 1, 0);
 
-int32_t find_lowest_risk(const Array2ui8& map, const Vector2i32 start, const Vector2i32 end)
-{
-    struct Node
-    {
-        bool closed = false;
-        bool open = false;
-        int32_t score = 0;
-        Vector2i32 position;
-    };
+        for(size_t y = 0; y < values.size(); y++)
+        {
+            if(values[y].size() != new_array.size.x)
+            {
+                throw aoc::puzzle_exception("Invalid width of row. ");
+            }
 
-    static const std::array offsets = {
-        Vector2i32{-1, 0 }, Vector2i32{1, 0 }, Vector2i32{0, -1 }, Vector2i32{0, 1 }
-    };
+            for (size_t x = 0; x < new_array.size.x; x++)
+            {
+                new_array(x, y) = static_cast<uint8_t>(values[y][x] - '0');
+            }
+        }
 
-    auto process_map = make_array2<Node>(map.size);
-    std::vector<Node*> open_nodes;
+        return new_array;
+    }
 
-    auto insert_open_node = [&process_map , &open_nodes](Vector2i32 position, int32_t score)
-    {
-        auto* node = &process_map.data[position.y][position.x];
-        node->position = position;
-        node->score = score;
-        node->open = true;
-        open_nodes.insert(
-	        std::lower_bound(open_nodes.begin(), open_nodes.end(), node, [](auto& lhs, auto& rhs)
-	        {
-				return lhs->score > rhs->score;
-	        }), node
-        );
-    };
-
-    auto is_closed_node = [&process_map](Vector2i32 position)
+    RiskMap load_binary_input(const Array2View<const uint8_t>& grid)
     {
-        return process_map.data[position.y][position.x].closed;
-    };
+        AOC_TRACE_SCOPE("load_binary_input");
 
-    auto is_open_node = [&process_map](Vector2i32 position)
+        auto new_array = aoc::make_halo_array2<uint8_t>(grid.size, 1, 0);
+        for (size_t y = 0; y < grid.size.y; y++)
+        {
+            const auto source = grid.row(y);
+            std::copy(source.begin(), source.end(), new_array.row(y).begin());
+        }
+        return new_array;
+    }
+
+    int32_t find_lowest_risk(const RiskMap& map, const Vector2s start, const Vector2s end)
     {
-        return process_map.data[position.y][position.x].open;
-    };
+        AOC_TRACE_SCOPE("find_lowest_risk");
 
-    insert_open_node(start, 0);
+        struct Node
+        {
+            bool closed = false;
+            bool open = false;
+            int32_t score = 0;
+            size_t index = 0;
+        };
 
-    while(!open_nodes.empty())
-    {
-        auto& next_node = *open_nodes.back();
-        open_nodes.erase(open_nodes.begin() + open_nodes.size() - 1);
-        next_node.closed = true;
+        const auto offsets = map.get_neighbour_offsets(orthogonal_offsets);
 
-        for(auto& offset : offsets)
+        // Shares the halo and indices of the map. Halo nodes are closed, so the search never leaves the map.
+        auto process_map = make_halo_array2<Node>(map.size, map.halo, Node{ true });
+        std::vector<Node*> open_nodes;
+
+        auto insert_open_node = [&process_map , &open_nodes](size_t index, int32_t score)
+        {
+            AOC_TRACE_SCOPE("insert_open_node");
+
+            auto* node = &process_map[index];
+            node->index = index;
+            node->score = score;
+            node->open = true;
+            open_nodes.insert(
+    	        std::lower_bound(open_nodes.begin(), open_nodes.end(), node, [](auto& lhs, auto& rhs)
+    	        {
+    				return lhs->score > rhs->score;
+    	        }), node
+            );
+        };
+
+        const auto end_index = map.get_index(end.x, end.y);
+        insert_open_node(map.get_index(start.x, start.y), 0);
+
+        while(!open_nodes.empty())
         {
-            auto neighbour_pos = next_node.position + offset;
+            AOC_TRACE_SCOPE("visit_node");
 
-            if(map.is_outside(neighbour_pos) || is_closed_node(neighbour_pos) || is_open_node(neighbour_pos))
-            {
-                continue;
-            }
-            
-            auto neighbour_score = next_node.score + (map.data[neighbour_pos.y][neighbour_pos.x]);
-            insert_open_node(neighbour_pos, neighbour_score);
+            auto& next_node = *open_nodes.back();
+            open_nodes.erase(open_nodes.begin() + open_nodes.size() - 1);
+            next_node.closed = true;
 
-            if (neighbour_pos == end)
+            for(const auto offset : offsets)
             {
-                return process_map.data[end.y][end.x].score;
+                const auto neighbour_index = next_node.index + offset;
+                const auto& neighbour = process_map[neighbour_index];
+
+                if(neighbour.closed || neighbour.open)
+                {
+                    continue;
+                }
+
+                auto neighbour_score = next_node.score + map[neighbour_index];
+                insert_open_node(neighbour_index, neighbour_score);
+
+                if (neighbour_index == end_index)
+                {
+                    return process_map[end_index].score;
+                }
             }
         }
+
+        throw aoc::puzzle_exception("Failed to find end!");    
     }
 
-    throw aoc::puzzle_exception("Failed to find end!");    
-}
+    size_t solve_part_1(const RiskMap& map)
+    {
+        const auto start = Vector2s{ 0, 0 };
+        const auto end = Vector2s{ map.size.x - 1, map.size.y - 1 };
+        return find_lowest_risk(map, start, end);
+    }
 
-size_t solve_part_1(const std::vector<std::string>& values)
-{
-    const auto map = parse_input(values);
-    const auto start = Vector2i32{ 0, 0 };
-    const auto end = Vector2i32{ static_cast<int32_t>(map.size.x - 1), static_cast<int32_t>(map.size.y - 1) };
-    return find_lowest_risk(map, start, end);
-}
+    RiskMap enlarge_map(const RiskMap& array2)
+    {
+        AOC_TRACE_SCOPE("enlarge_map");
 
-Array2ui8 enlarge_map(const Array2ui8& array2)
-{
-    auto new_array = make_array2<uint8_t>(array2.size * 5);
+        auto new_array = make_halo_array2<uint8_t>(array2.size * 5, array2.halo, 0);
 
-    for(size_t ys = 0; ys < 5; ys++)
-    {
-        for (size_t y = 0; y < array2.size.y; y++)
+        parallel_for_rows(new_array, [&array2](const size_t target_y, const std::span<uint8_t> target_row)
         {
-            size_t target_y = y + (ys * array2.size.y);
+            const auto ys = target_y / array2.size.y;
+            const auto source_row = array2.row(target_y % array2.size.y);
 
             for (size_t xs = 0; xs < 5; xs++)
             {
-                for (size_t x = 0; x < array2.size.x; x++)
+                const auto target = target_row.subspan(xs * array2.size.x, array2.size.x);
+                for (size_t x = 0; x < source_row.size(); x++)
                 {
-                    size_t target_x = x + (xs * array2.size.x);
-                    new_array.data[target_y][target_x] = (((array2.data[y][x]) + (ys + xs) - 1) % 9) + 1;
+                    target[x] = static_cast<uint8_t>(((source_row[x] + (ys + xs) - 1) % 9) + 1);
                 }
             }
-        }
+        });
+
+        return new_array;
     }
 
-    return new_array;
-}
+    size_t solve_part_2(const RiskMap& map)
+    {
+        const auto enlarged_map = enlarge_map(map);
+        const auto start = Vector2s{ 0, 0 };
+        const auto end = Vector2s{ enlarged_map.size.x - 1, enlarged_map.size.y - 1 };
+        return find_lowest_risk(enlarged_map, start, end);
+    }
 
-size_t solve_part_2(const std::vector<std::string>& values)
-{
-    const auto map = parse_input(values);
-    const auto enlarged_map = enlarge_map(map);
-    const auto start = Vector2i32{ 0, 0 };
-    const auto end = Vector2i32{ static_cast<int32_t>(enlarged_map.size.x - 1), static_cast<int32_t>(enlarged_map.size.y - 1) };
-    return find_lowest_risk(enlarged_map, start, end);
-}
-
-int main() {
-    solve_puzzles(
-        aoc::read_input<15, std::string>(),
+    const bool registered = aoc::register_parsed_puzzle<15, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
+        parse_input,
         solve_part_1,
         solve_part_2
     );
+
+    const bool registered_binary = aoc::register_binary_input<15, std::string>(load_binary_input);
+
 }
\ No newline at end of file
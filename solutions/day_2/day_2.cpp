@@ -1,54 +1,118 @@
 #include "utility.hpp"
 
-int32_t solve_part_1(const std::vector<std::string>& values)
+namespace day_2
 {
-    int32_t x = 0, y = 0;
-    for (size_t i = 0; i < values.size(); i += 2)
-    {
-        const auto& command = values[i];
-        const auto value = atoi(values[i + 1].c_str());
 
-        switch (command[0])
+    int64_t solve_part_1(const std::vector<std::string>& values)
+    {
+        int64_t x = 0, y = 0;
+        for (size_t i = 0; i < values.size(); i += 2)
         {
-        case 'f': x += value; break;
-        case 'd': y += value; break;
-        case 'u': y -= value; break;
-        default: throw aoc::puzzle_exception("Invalid command:" + command);
+            const auto& command = values[i];
+            const auto value = atoi(values[i + 1].c_str());
+
+            switch (command[0])
+            {
+            case 'f': x += value; break;
+            case 'd': y += value; break;
+            case 'u': y -= value; break;
+            default: throw aoc::puzzle_exception("Invalid command:" + command);
+            }
         }
-    }
 
-    return x * y;
-}
+        return x * y;
+    }
 
-int32_t solve_part_2(const std::vector<std::string>& values)
-{
-    int32_t x = 0, y = 0, aim = 0;
-    for (size_t i = 0; i < values.size(); i += 2)
+    int64_t solve_part_2(const std::vector<std::string>& values)
     {
-        const auto& command = values[i];
-        const auto value = atoi(values[i + 1].c_str());
-
-        switch (command[0])
+        int64_t x = 0, y = 0, aim = 0;
+        for (size_t i = 0; i < values.size(); i += 2)
         {
-        case 'f':
+            const auto& command = values[i];
+            const auto value = atoi(values[i + 1].c_str());
+
+            switch (command[0])
+            {
+            case 'f':
+            {
+                x += value;
+                y += aim * value;
+            } break;
+            case 'd': aim += value; break;
+            case 'u': aim -= value; break;
+            default: throw aoc::puzzle_exception("Invalid command:" + command);
+            }
+        }
+
+        return x * y;
+    }
+
+    // Streaming
+    std::pair<char, int32_t> parse_command(std::string_view line)
+    {
+        const auto separator = line.find(' ');
+        int32_t value = 0;
+        if (separator == std::string_view::npos ||
+            std::from_chars(line.data() + separator + 1, line.data() + line.size(), value).ec != std::errc())
         {
-            x += value;
-            y += aim * value;
-        } break;
-        case 'd': aim += value; break;
-        case 'u': aim -= value; break;
-        default: throw aoc::puzzle_exception("Invalid command:" + command);
+            throw aoc::puzzle_exception("Invalid command:" + std::string(line));
         }
+        return { line[0], value };
+    }
+
+    int64_t stream_part_1(aoc::line_stream& stream)
+    {
+        int64_t x = 0, y = 0;
+        stream.for_each_line([&](std::string_view line)
+        {
+            const auto [command, value] = parse_command(line);
+
+            switch (command)
+            {
+            case 'f': x += value; break;
+            case 'd': y += value; break;
+            case 'u': y -= value; break;
+            default: throw aoc::puzzle_exception("Invalid command:" + std::string(line));
+            }
+        });
+
+        return x * y;
     }
 
-    return x * y;
-}
+    int64_t stream_part_2(aoc::line_stream& stream)
+    {
+        int64_t x = 0, y = 0, aim = 0;
+        stream.for_each_line([&](std::string_view line)
+        {
+            const auto [command, value] = parse_command(line);
+
+            switch (command)
+            {
+            case 'f':
+            {
+                x += value;
+                y += aim * value;
+            } break;
+            case 'd': aim += value; break;
+            case 'u': aim -= value; break;
+            default: throw aoc::puzzle_exception("Invalid command:" + std::string(line));
+            }
+        });
 
-int main()
-{
-    aoc::solve_puzzles(
-        aoc::read_input<2, std::string>(true, true),
+        return x * y;
+    }
+
+    const bool registered = aoc::register_puzzle<2, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{ .skip_empty_lines = true, .split_words = true },
         solve_part_1,
         solve_part_2
     );
+
+    const bool registered_streaming = aoc::register_streaming_parts<2>(
+        aoc::input_format{ .skip_empty_lines = true },
+        stream_part_1,
+        stream_part_2
+    );
+
 }
\ No newline at end of file
@@ -1,102 +1,151 @@
 #include "utility.hpp"
 
-int32_t count_one_bits(const std::vector<std::string>& values, int32_t column_index)
+namespace day_3
 {
-    int32_t count = 0;
 
-    for (const auto& value : values)
+    int32_t count_one_bits(const std::vector<std::string>& values, size_t column_index)
     {
-        auto bit = static_cast<int32_t>(value[column_index] - '0');
-        if (bit == 1)
+        int32_t count = 0;
+
+        for (const auto& value : values)
         {
-            ++count;
+            auto bit = static_cast<int32_t>(value[column_index] - '0');
+            if (bit == 1)
+            {
+                ++count;
+            }
         }
-    }
 
-    return count;
-}
-
-int32_t solve_part_1(const std::vector<std::string>& values)
-{
-    int32_t gamma = 0;
-    int32_t epsilon = 0;
+        return count;
+    }
 
-    const size_t bit_count = values[0].size();
-    for (int32_t i = 0; i < bit_count; i++)
+    int32_t solve_part_1(const std::vector<std::string>& values)
     {
-        const auto one_bits = count_one_bits(values, i);
-        const auto zero_bits = static_cast<int32_t>(values.size()) - one_bits;
+        int32_t gamma = 0;
+        int32_t epsilon = 0;
 
-        gamma = (gamma << 1);
-        epsilon = (epsilon << 1);
-
-        if (one_bits > zero_bits)
-        {
-            gamma |= 1;
-        }
-        else
+        const size_t bit_count = values[0].size();
+        for (size_t i = 0; i < bit_count; i++)
         {
-            epsilon |= 1;
+            const auto one_bits = count_one_bits(values, i);
+            const auto zero_bits = static_cast<int32_t>(values.size()) - one_bits;
+
+            gamma = (gamma << 1);
+            epsilon = (epsilon << 1);
+
+            if (one_bits > zero_bits)
+            {
+                gamma |= 1;
+            }
+            else
+            {
+                epsilon |= 1;
+            }
         }
-    }
 
-    return gamma * epsilon;
-}
+        return gamma * epsilon;
+    }
 
 
-int32_t solve_part_2(const std::vector<std::string>& values)
-{
-    auto solve = [&](const char one_token, const char zero_token) -> std::string
+    int32_t solve_part_2(const std::vector<std::string>& values)
     {
-        auto values_left = values;
-
-        const size_t bit_count = values[0].size();
-        for (int32_t i = 0; i < bit_count && values_left.size() > 1; i++)
+        auto solve = [&](const char one_token, const char zero_token) -> std::string
         {
-            const auto one_bits = count_one_bits(values_left, i);
-            const auto zero_bits = static_cast<int32_t>(values_left.size()) - one_bits;
+            auto values_left = values;
+
+            const size_t bit_count = values[0].size();
+            for (size_t i = 0; i < bit_count && values_left.size() > 1; i++)
+            {
+                const auto one_bits = count_one_bits(values_left, i);
+                const auto zero_bits = static_cast<int32_t>(values_left.size()) - one_bits;
 
-            const auto keep_token = one_bits >= zero_bits ? one_token : zero_token;
+                const auto keep_token = one_bits >= zero_bits ? one_token : zero_token;
 
-            values_left.erase(
-                std::remove_if(values_left.begin(), values_left.end(), [&](auto value) { return value[i] != keep_token; }),
-                values_left.end());
-        }
+                values_left.erase(
+                    std::remove_if(values_left.begin(), values_left.end(), [&](auto value) { return value[i] != keep_token; }),
+                    values_left.end());
+            }
 
-        if (values_left.size() != 1)
+            if (values_left.size() != 1)
+            {
+                throw aoc::puzzle_exception("Failed to find value.");
+            }
+
+            return values_left[0];
+        };
+
+        auto to_number = [](std::string value) -> int32_t
         {
-            throw aoc::puzzle_exception("Failed to find value.");
-        }
+            int32_t result = 0;
+            for (size_t i = 0; i < value.size(); i++)
+            {
+                result = (result << 1);
+                if (value[i] == '1')
+                {
+                    result |= 1;
+                }
+            }
 
-        return values_left[0];
-    };
+            return result;
+        };
 
-    auto to_number = [](std::string value) -> int32_t
+        const auto oxygen = to_number(solve('1', '0'));
+        const auto co2 = to_number(solve('0', '1'));
+
+        return oxygen * co2;
+    }
+
+    // Streaming, part 2 filters the values repeatedly and needs all of them.
+    int32_t stream_part_1(aoc::line_stream& stream)
     {
-        int32_t result = 0;
-        for (int32_t i = 0; i < value.size(); i++)
+        std::vector<int32_t> one_bits;
+        int32_t value_count = 0;
+        stream.for_each_line([&](std::string_view line)
         {
-            result = (result << 1);
-            if (value[i] == '1')
+            if (one_bits.empty())
             {
-                result |= 1;
+                one_bits.resize(line.size(), 0);
             }
-        }
+            for (size_t i = 0; i < one_bits.size() && i < line.size(); i++)
+            {
+                one_bits[i] += line[i] == '1' ? 1 : 0;
+            }
+            ++value_count;
+        });
 
-        return result;
-    };
+        int32_t gamma = 0;
+        int32_t epsilon = 0;
 
-    const auto oxygen = to_number(solve('1', '0'));
-    const auto co2 = to_number(solve('0', '1'));
+        for (const auto column_one_bits : one_bits)
+        {
+            const auto zero_bits = value_count - column_one_bits;
 
-    return oxygen * co2;
-}
+            gamma = (gamma << 1);
+            epsilon = (epsilon << 1);
 
-int main()
-{
-    aoc::solve_puzzles(
-        aoc::read_input<3, std::string>(true),
+            if (column_one_bits > zero_bits)
+            {
+                gamma |= 1;
+            }
+            else
+            {
+                epsilon |= 1;
+            }
+        }
+
+        return gamma * epsilon;
+    }
+
+    const bool registered = aoc::register_puzzle<3, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{ .skip_empty_lines = true },
         solve_part_1,
         solve_part_2
     );
+
+    const bool registered_streaming = aoc::register_streaming_parts<3>(
+        aoc::input_format{ .skip_empty_lines = true },
+        stream_part_1
+    );
+
 }
\ No newline at end of file
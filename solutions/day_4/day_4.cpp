@@ -2,217 +2,224 @@
 #include <array>
 #include <sstream>
 
-struct Number
+namespace day_4
 {
-    int32_t value;
-    bool marked;
-};
 
-struct Board
-{
-    std::array<Number, 25> numbers;
-};
+    struct Number
+    {
+        int32_t value;
+        bool marked;
+    };
 
-struct Game
-{
-    std::vector<int32_t> draw_numbers;
-    std::vector<Board> boards;
-};
+    struct Board
+    {
+        std::array<Number, 25> numbers;
+    };
 
+    struct Game
+    {
+        std::vector<int32_t> draw_numbers;
+        std::vector<Board> boards;
+    };
 
-std::vector<int32_t> parse_draw_numbers(const std::string& line)
-{
-    std::vector<int32_t> numbers = {};
-    int32_t value = 0;
-    char dummy = 0;
 
-    std::stringstream ss(line);
-    while (!ss.eof())
+    std::vector<int32_t> parse_draw_numbers(const std::string& line)
     {
-        ss >> value >> dummy;
-        numbers.push_back(value);
-    }
-    
-    return numbers;
-}
+        std::vector<int32_t> numbers = {};
+        int32_t value = 0;
+        char dummy = 0;
 
-Board parse_board(std::vector<std::string>::const_iterator begin, std::vector<std::string>::const_iterator end)
-{
-    Board board{};
+        std::stringstream ss(line);
+        while (!ss.eof())
+        {
+            ss >> value >> dummy;
+            numbers.push_back(value);
+        }
+
+        return numbers;
+    }
 
-    int32_t value = 0;
-    size_t i = 0;
-    for (auto it = begin; it != end; it++)
+    Board parse_board(std::vector<std::string>::const_iterator begin, std::vector<std::string>::const_iterator end)
     {
-        std::stringstream ss(*it);
+        Board board{};
 
-        for (size_t j = 0; j < 5; j++)
+        size_t i = 0;
+        for (auto it = begin; it != end; it++)
         {
-            ss >> board.numbers[i++].value;
-        }  
-    }
+            std::stringstream ss(*it);
 
-    return board;
-}
+            for (size_t j = 0; j < 5; j++)
+            {
+                ss >> board.numbers[i++].value;
+            }  
+        }
 
-Game parse_game(const std::vector<std::string>& values)
-{
-    auto draw_numbers = parse_draw_numbers(values.front());
+        return board;
+    }
 
-    std::vector<Board> boards;
-   
-    for(auto it = values.begin() + 1; it != values.end(); )
+    Game parse_game(const std::vector<std::string>& values)
     {
-        boards.push_back(parse_board(it, it + 5));
-        it += 5;
-    }
+        AOC_TRACE_SCOPE("parse_game");
 
-    return { std::move(draw_numbers), std::move(boards) };
-}
+        auto draw_numbers = parse_draw_numbers(values.front());
 
-bool is_winner(Board& board, int32_t index)
-{
-    const auto x = index % 5;
-    const auto y = index / 5;
+        std::vector<Board> boards;
 
-    auto check_hor = [&]()
-    {
-        for (int32_t i = 0; i < 5; i++)
+        for(auto it = values.begin() + 1; it != values.end(); )
         {
-            const auto pos = (y * 5) + i;
-            if (board.numbers[pos].marked == false)
-            {
-                return false;
-            }
+            boards.push_back(parse_board(it, it + 5));
+            it += 5;
         }
 
-        return true;
-    };
+        return { std::move(draw_numbers), std::move(boards) };
+    }
 
-    auto check_vert = [&]()
+    bool is_winner(Board& board, int32_t index)
     {
-        for (int32_t i = 0; i < 5; i++)
+        const auto x = index % 5;
+        const auto y = index / 5;
+
+        auto check_hor = [&]()
         {
-            const auto pos = x + (i * 5);
-            if (board.numbers[pos].marked == false)
+            for (int32_t i = 0; i < 5; i++)
             {
-                return false;
+                const auto pos = (y * 5) + i;
+                if (board.numbers[pos].marked == false)
+                {
+                    return false;
+                }
             }
-        }
-
-        return true;
-    };
 
-    return check_hor() || check_vert();
-}
+            return true;
+        };
 
-bool set_and_check_board_number(Board& board, int32_t number)
-{
-    for (int32_t i = 0; i < board.numbers.size(); i++)
-    {
-        auto& board_number = board.numbers[i];
-        if (board_number.value == number)
+        auto check_vert = [&]()
         {
-            board_number.marked = true;
-            if (is_winner(board, i))
+            for (int32_t i = 0; i < 5; i++)
             {
-                return true;
+                const auto pos = x + (i * 5);
+                if (board.numbers[pos].marked == false)
+                {
+                    return false;
+                }
             }
 
-        }
-    }
+            return true;
+        };
 
-    return false;
-}
+        return check_hor() || check_vert();
+    }
 
-std::pair<Board*, int32_t> find_first_winner(Game& game)
-{
-    for (auto& draw_number : game.draw_numbers)
+    bool set_and_check_board_number(Board& board, int32_t number)
     {
-        for (auto& board : game.boards)
+        for (size_t i = 0; i < board.numbers.size(); i++)
         {
-            if (set_and_check_board_number(board, draw_number))
+            auto& board_number = board.numbers[i];
+            if (board_number.value == number)
             {
-                return { &board, draw_number };
+                board_number.marked = true;
+                if (is_winner(board, i))
+                {
+                    return true;
+                }
+
             }
         }
-    }
 
-    return { nullptr, 0 };
-}
+        return false;
+    }
 
-std::pair<Board*, int32_t> find_last_winner(Game& game)
-{
-    for (auto& draw_number : game.draw_numbers)
+    std::pair<Board*, int32_t> find_first_winner(Game& game)
     {
-        for (auto it = game.boards.begin(); it != game.boards.end();)
+        AOC_TRACE_SCOPE("find_first_winner");
+
+        for (auto& draw_number : game.draw_numbers)
         {
-            auto& board = *it;
-            if (set_and_check_board_number(board, draw_number))
+            for (auto& board : game.boards)
             {
-                if (game.boards.size() == 1)
+                if (set_and_check_board_number(board, draw_number))
                 {
                     return { &board, draw_number };
                 }
-
-                it = game.boards.erase(it);
             }
-            else
+        }
+
+        return { nullptr, 0 };
+    }
+
+    std::pair<Board*, int32_t> find_last_winner(Game& game)
+    {
+        AOC_TRACE_SCOPE("find_last_winner");
+
+        for (auto& draw_number : game.draw_numbers)
+        {
+            for (auto it = game.boards.begin(); it != game.boards.end();)
             {
-                ++it;
+                auto& board = *it;
+                if (set_and_check_board_number(board, draw_number))
+                {
+                    if (game.boards.size() == 1)
+                    {
+                        return { &board, draw_number };
+                    }
+
+                    it = game.boards.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
             }
         }
-    }
 
-    return { nullptr, 0 };
-}
+        return { nullptr, 0 };
+    }
 
-int32_t sum_unmarked(const Board& board)
-{
-    int32_t sum = 0;
-    for (size_t i = 0; i < board.numbers.size(); i++)
+    int32_t sum_unmarked(const Board& board)
     {
-        if (!board.numbers[i].marked)
+        int32_t sum = 0;
+        for (size_t i = 0; i < board.numbers.size(); i++)
         {
-            sum += board.numbers[i].value;
+            if (!board.numbers[i].marked)
+            {
+                sum += board.numbers[i].value;
+            }
         }
+        return sum;
     }
-    return sum;
-}
 
-int32_t solve_part_1(const std::vector<std::string>& values)
-{
-    auto game = parse_game(values);
-    auto[winning_board, winning_number] = find_first_winner(game);
-    if (winning_board == nullptr)
+    int32_t solve_part_1(Game game)
     {
-        throw aoc::puzzle_exception("Failed to find winning board.");
-    }
+        auto[winning_board, winning_number] = find_first_winner(game);
+        if (winning_board == nullptr)
+        {
+            throw aoc::puzzle_exception("Failed to find winning board.");
+        }
 
-    int32_t sum = sum_unmarked(*winning_board);
+        int32_t sum = sum_unmarked(*winning_board);
 
-    return sum * winning_number;
-}
+        return sum * winning_number;
+    }
 
-int32_t solve_part_2(const std::vector<std::string>& values)
-{
-    auto game = parse_game(values);
-    auto [winning_board, winning_number] = find_last_winner(game);
-    if (winning_board == nullptr)
+    int32_t solve_part_2(Game game)
     {
-        throw aoc::puzzle_exception("Failed to find winning board.");
-    }
+        auto [winning_board, winning_number] = find_last_winner(game);
+        if (winning_board == nullptr)
+        {
+            throw aoc::puzzle_exception("Failed to find winning board.");
+        }
 
-    int32_t sum = sum_unmarked(*winning_board);
+        int32_t sum = sum_unmarked(*winning_board);
 
-    return sum * winning_number;
-}
+        return sum * winning_number;
+    }
 
-int main()
-{
-    aoc::solve_puzzles(
-        aoc::read_input<4, std::string>(true),
+    const bool registered = aoc::register_parsed_puzzle<4, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{ .skip_empty_lines = true },
+        parse_game,
         solve_part_1,
         solve_part_2
     );
+
 }
\ No newline at end of file
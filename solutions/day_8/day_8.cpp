@@ -1,214 +1,253 @@
 #include "utility.hpp"
 #include <array>
-#include <functional>
-#include <sstream>
+#include <string_view>
+#include <memory_resource>
 
-using SignalPatterns = std::array<std::string, 10>;
-using OutputValues = std::array<std::string, 4>;
-
-struct Display
+namespace day_8
 {
-    SignalPatterns signal_patterns;
-    OutputValues output_values;
-};
 
-using Displays = std::vector<Display>;
+    using SignalPatterns = std::array<std::string, 10>;
+    using OutputValues = std::array<std::string, 4>;
 
-Displays parse_input(const std::vector<std::string>& values)
-{
-    Displays displays;
+    struct Display
+    {
+        SignalPatterns signal_patterns;
+        OutputValues output_values;
+    };
 
-	for(const auto& value : values)
-	{
-        std::stringstream ss(value);
+    using Displays = std::vector<Display>;
 
-        auto& display = *displays.insert(displays.end(), Display{});
+    // Next token separated by spaces, advancing `line` past it. Empty at the end of the line.
+    std::string_view next_token(std::string_view& line)
+    {
+        const auto begin = line.find_first_not_of(' ');
+        if (begin == std::string_view::npos)
+        {
+            line = {};
+            return {};
+        }
 
-        std::string token;
+        const auto end = std::min(line.find(' ', begin), line.size());
+        const auto token = line.substr(begin, end - begin);
+        line.remove_prefix(end);
+        return token;
+    }
 
-		for(size_t i = 0; i < std::tuple_size_v<SignalPatterns>; i++)
-		{
-            ss >> token;
-            display.signal_patterns[i] = token;
-		}
+    Displays parse_input(const std::vector<std::string>& values)
+    {
+        AOC_TRACE_SCOPE("parse_input");
 
-        ss >> token;
+        Displays displays;
+        displays.reserve(values.size());
 
-        for (size_t i = 0; i < std::tuple_size_v<OutputValues>; i++)
-        {
-            ss >> token;
-            display.output_values[i] = token;
-        }
+    	for(const auto& value : values)
+    	{
+            std::string_view line = value;
 
-        if(ss.fail())
-        {
-            throw aoc::puzzle_exception("Unexpected end of line.");
-        }
-	}
+            auto& display = *displays.insert(displays.end(), Display{});
 
-    return displays;
-}
+            bool is_complete = true;
+            auto read_token = [&](std::string& target)
+            {
+                const auto token = next_token(line);
+                is_complete = is_complete && !token.empty();
+                target = token;
+            };
 
-void sort_display_tokens(Displays& displays)
-{
-	for(auto& display : displays)
-	{
-        for (auto& signal_token : display.signal_patterns)
-        {
-            std::sort(signal_token.begin(), signal_token.end());
-        }
-        for (auto& output_token : display.output_values)
+    		for(size_t i = 0; i < std::tuple_size_v<SignalPatterns>; i++)
+    		{
+                read_token(display.signal_patterns[i]);
+    		}
+
+            std::string separator;
+            read_token(separator);
+
+            for (size_t i = 0; i < std::tuple_size_v<OutputValues>; i++)
+            {
+                read_token(display.output_values[i]);
+            }
+
+            if(!is_complete)
+            {
+                throw aoc::puzzle_exception("Unexpected end of line.");
+            }
+    	}
+
+        return displays;
+    }
+
+    void sort_display_tokens(Displays& displays)
+    {
+        AOC_TRACE_SCOPE("sort_display_tokens");
+
+    	for(auto& display : displays)
+    	{
+            for (auto& signal_token : display.signal_patterns)
+            {
+                std::sort(signal_token.begin(), signal_token.end());
+            }
+            for (auto& output_token : display.output_values)
+            {
+                std::sort(output_token.begin(), output_token.end());
+            }
+    	}
+    }
+
+    Displays parse_sorted_input(const std::vector<std::string>& values)
+    {
+        auto displays = parse_input(values);
+        sort_display_tokens(displays);
+        return displays;
+    }
+
+    // Part 1
+    int32_t count_part_1(const Displays& displays)
+    {
+        AOC_TRACE_SCOPE("count_part_1");
+
+        int32_t count = 0;
+
+        for (const auto& display : displays)
         {
-            std::sort(output_token.begin(), output_token.end());
+            for (const auto& output_value : display.output_values)
+            {
+                if (output_value.size() == 2 || output_value.size() == 3 || output_value.size() == 4 || output_value.size() == 7)
+                {
+                    ++count;
+                }
+            }
         }
-	}
-}
 
-// Part 1
-int32_t count_part_1(Displays& displays)
-{
-    int32_t count = 0;
+        return count;
+    }
 
-    for (auto& display : displays)
+    int32_t solve_part_1(const Displays& displays)
     {
-        for (auto& output_value : display.output_values)
+        return count_part_1(displays);
+    }
+
+    // Part 2
+    bool token_contains(const std::string_view token, const std::string_view contains)
+    {
+        for(const auto c : contains)
         {
-            if (output_value.size() == 2 || output_value.size() == 3 || output_value.size() == 4 || output_value.size() == 7)
+            auto it = std::find(token.begin(), token.end(), c);
+            if(it == token.end())
             {
-                ++count;
+                return false;
             }
         }
-    }
 
-    return count;
-}
+        return true;
+    }
 
-int32_t solve_part_1(const std::vector<std::string>& values)
-{
-    auto displays = parse_input(values);
-    sort_display_tokens(displays);
-    return count_part_1(displays);
-}
+    using Possibilities = std::pmr::vector<std::string_view>;
 
-// Part 2
-bool token_contains(const std::string& token, const std::string& contains)
-{
-    for(const auto c : contains)
+    template<typename TCheckFunction>
+    std::string_view find_and_erase_expected_token(Possibilities& possible_tokens, TCheckFunction check_function)
     {
-        auto it = std::find(token.begin(), token.end(), c);
-        if(it == token.end())
+        for (auto it = possible_tokens.begin(); it != possible_tokens.end(); it++)
         {
-            return false;
+            const auto posibility = *it;
+            if(check_function(posibility))
+            {
+                possible_tokens.erase(it);
+                return posibility;
+            }
         }
+        return {};
     }
 
-    return true;
-}
-
-std::string find_and_erase_expected_token(std::vector<std::string>& possible_tokens, std::function<bool(const std::string)> check_function)
-{
-    for (auto it = possible_tokens.begin(); it != possible_tokens.end(); it++)
+    int32_t build_output_number(const std::array<std::string_view, 10>& tokens, const OutputValues& output_values)
     {
-        auto posibility = *it;
-        if(check_function(posibility))
+        int32_t result = 0;
+        for (const auto& output_value : output_values)
         {
-            possible_tokens.erase(it);
-            return posibility;
+        	const auto it = std::find(tokens.begin(), tokens.end(), output_value);
+
+            result *= 10;
+            result += static_cast<int32_t>(it - tokens.begin());
         }
+
+        return result;
     }
-    return "";
-}
 
-int32_t build_output_number(std::array<std::string, 10>& tokens, const OutputValues& output_values)
-{
-    int32_t result = 0;
-    for (const auto& output_value : output_values)
+    int32_t count_part_2_display(const Display& display, Possibilities& possibilities_2_3_5, Possibilities& possibilities_0_6_9)
     {
-    	const auto it = std::find_if(tokens.begin(), tokens.end(), [&](auto token)
+        possibilities_2_3_5.clear(); // Length of 5
+        possibilities_0_6_9.clear(); // Length of 6
+        std::array<std::string_view, 10> found_tokens;
+
+        for (const auto& signal_pattern : display.signal_patterns)
+        {
+            switch(signal_pattern.size())
+            {
+    	        case 2: found_tokens[1] = signal_pattern; break; // 1
+    	        case 3: found_tokens[7] = signal_pattern; break; // 7
+    	        case 4: found_tokens[4] = signal_pattern; break; // 4
+    	        case 7: found_tokens[8] = signal_pattern; break; // 8
+    	        case 5: possibilities_2_3_5.push_back(signal_pattern); break;
+    	        case 6: possibilities_0_6_9.push_back(signal_pattern); break;
+    	        default: break;
+            }
+        }
+
+        found_tokens[0] = find_and_erase_expected_token(possibilities_0_6_9, [&](const auto posibility)
+            {
+                return token_contains(posibility, found_tokens[1]) &&
+                    !token_contains(posibility, found_tokens[4]) &&
+                    token_contains(posibility, found_tokens[7]);
+            });
+        found_tokens[9] = find_and_erase_expected_token(possibilities_0_6_9, [&](const auto posibility)
             {
-                return token == output_value;
+                return !token_contains(posibility, found_tokens[0]) &&
+                    token_contains(posibility, found_tokens[1]) &&
+                    token_contains(posibility, found_tokens[4]) &&
+                    token_contains(posibility, found_tokens[7]);
             });
+        found_tokens[6] = possibilities_0_6_9.front();
+        found_tokens[5] = find_and_erase_expected_token(possibilities_2_3_5, [&](const auto posibility)
+            {
+                return !token_contains(posibility, found_tokens[1]) &&
+                    !token_contains(posibility, found_tokens[7]) &&
+                    token_contains(found_tokens[6], posibility);
+            });
+        found_tokens[3] = find_and_erase_expected_token(possibilities_2_3_5, [&](const auto posibility)
+            {
+                return token_contains(posibility, found_tokens[1]);
+            });
+        found_tokens[2] = possibilities_2_3_5.front();
 
-        result *= 10;
-        result += static_cast<int32_t>(it - tokens.begin());
+        return build_output_number(found_tokens, display.output_values);
     }
 
-    return result;
-}
+    int32_t count_part_2(const Displays& displays)
+    {
+        AOC_TRACE_SCOPE("count_part_2");
 
-int32_t count_part_2_display(Display& display)
-{
-    std::vector<std::string> possibilities_2_3_5; // Length of 5
-    std::vector<std::string> possibilities_0_6_9; // Length of 6
-    std::array<std::string, 10> found_tokens;
+        int32_t count = 0;
+        Possibilities possibilities_2_3_5(aoc::get_part_memory_resource());
+        Possibilities possibilities_0_6_9(aoc::get_part_memory_resource());
 
-    for (auto& signal_pattern : display.signal_patterns)
-    {
-        switch(signal_pattern.size())
+        for (const auto& display : displays)
         {
-	        case 2: found_tokens[1] = signal_pattern; break; // 1
-	        case 3: found_tokens[7] = signal_pattern; break; // 7
-	        case 4: found_tokens[4] = signal_pattern; break; // 4
-	        case 7: found_tokens[8] = signal_pattern; break; // 8
-	        case 5: possibilities_2_3_5.push_back(signal_pattern); break;
-	        case 6: possibilities_0_6_9.push_back(signal_pattern); break;
-	        default: break;
+            count += count_part_2_display(display, possibilities_2_3_5, possibilities_0_6_9);
         }
-    }
 
-    found_tokens[0] = find_and_erase_expected_token(possibilities_0_6_9, [&](const auto posibility)
-        {
-            return token_contains(posibility, found_tokens[1]) &&
-                !token_contains(posibility, found_tokens[4]) &&
-                token_contains(posibility, found_tokens[7]);
-        });
-    found_tokens[9] = find_and_erase_expected_token(possibilities_0_6_9, [&](const auto posibility)
-        {
-            return !token_contains(posibility, found_tokens[0]) &&
-                token_contains(posibility, found_tokens[1]) &&
-                token_contains(posibility, found_tokens[4]) &&
-                token_contains(posibility, found_tokens[7]);
-        });
-    found_tokens[6] = possibilities_0_6_9.front();
-    found_tokens[5] = find_and_erase_expected_token(possibilities_2_3_5, [&](const auto posibility)
-        {
-            return !token_contains(posibility, found_tokens[1]) &&
-                !token_contains(posibility, found_tokens[7]) &&
-                token_contains(found_tokens[6], posibility);
-        });
-    found_tokens[3] = find_and_erase_expected_token(possibilities_2_3_5, [&](const auto posibility)
-        {
-            return token_contains(posibility, found_tokens[1]);
-        });
-    found_tokens[2] = possibilities_2_3_5.front();
-
-    return build_output_number(found_tokens, display.output_values);
-}
-
-int32_t count_part_2(Displays& displays)
-{
-    int32_t count = 0;
+        return count;
+    }
 
-    for (auto& display : displays)
+    int32_t solve_part_2(const Displays& displays)
     {
-        count += count_part_2_display(display);
+        return count_part_2(displays);
     }
 
-    return count;
-}
-
-int32_t solve_part_2(const std::vector<std::string>& values)
-{
-    auto displays = parse_input(values);
-    sort_display_tokens(displays);
-    return count_part_2(displays);
-}
-
-int main()
-{
-    aoc::solve_puzzles(
-        aoc::read_input<8, std::string>(),
+    const bool registered = aoc::register_parsed_puzzle<8, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
+        parse_sorted_input,
         solve_part_1,
         solve_part_2
     );
+
 }
\ No newline at end of file
@@ -1,206 +1,215 @@
 #include "utility.hpp"
-#include <array>
+#include "halo_array2.hpp"
+#include "parallel.hpp"
 #include <numeric>
+#include <memory_resource>
 
-struct Point
+namespace day_9
 {
-    int32_t x;
-    int32_t y;
 
-    Point operator +(const Point& rhs) const
-    {
-        return Point{ x + rhs.x, y + rhs.y };
-    }
-
-    bool operator ==(const Point& rhs) const
-    {
-        return  x == rhs.x && y == rhs.y;
-    }
-};
+    using HeightMap = aoc::HaloArray2<uint8_t>;
 
-using HeightMapRow = std::vector<uint8_t>;
-using HeightMapData = std::vector<HeightMapRow>;
-
-struct HeightMap
-{
-    size_t width;
-    HeightMapData data;
-};
-
-HeightMap parse_input(const std::vector<std::string>& values)
-{
-    HeightMap height_map{ values[0].size(), {} };
+    // Higher than any height, so the halo never makes a neighbour a low point and never joins a basin.
+    constexpr uint8_t halo_height = 10;
 
-    for(const auto& value : values)
+    HeightMap parse_input(const std::vector<std::string>& values)
     {
-        if(value.size() != height_map.width)
+        AOC_TRACE_SCOPE("parse_input");
+
+        if(values.empty() || values.front().empty())
         {
-            throw aoc::puzzle_exception("Invalid width of row. ");
+            throw aoc::puzzle_exception("Input is empty.");
         }
 
-    	auto& row = *height_map.data.insert(height_map.data.end(), HeightMapRow{});
-        row.reserve(height_map.width);
+        auto height_map = aoc::make_halo_array2<uint8_t>(aoc::Vector2s{ values.front().size(), values.size() }, 1, halo_height);
 
-    	for(const auto number : value)
+        for(size_t y = 0; y < values.size(); y++)
         {
-            row.push_back(number - '0');
+            if(values[y].size() != height_map.size.x)
+            {
+                throw aoc::puzzle_exception("Invalid width of row. ");
+            }
+
+            auto row = height_map.row(y);
+        	for(size_t x = 0; x < row.size(); x++)
+            {
+                row[x] = static_cast<uint8_t>(values[y][x] - '0');
+            }
         }
+        return height_map;
     }
-    return height_map;
-}
-
-bool is_inside_map(const HeightMap& height_map, const Point position)
-{
-    return
-        position.x >= 0 && position.y >= 0 &&
-        position.x < static_cast<int32_t>(height_map.width) && position.y < static_cast<int32_t>(height_map.data.size());
-};
 
-bool is_low_point(const HeightMap& height_map, const Point position)
-{
-    static const std::array surroundings = {
-        Point{ -1, -1 }, Point{ 0, -1 }, Point{ 1, -1 },
-        Point{ -1, 0 }, Point{ 1, 0 },
-        Point{ -1, 1 }, Point{ 0, 1 }, Point{ 1, 1 }
-    };
-
-    for(const auto& surrounding : surroundings)
+    HeightMap load_binary_input(const aoc::Array2View<const uint8_t>& grid)
     {
-        const auto surrounding_position = position + surrounding;
-	    if(!is_inside_map(height_map, surrounding_position))
-	    {
-            continue;
-	    }
+        AOC_TRACE_SCOPE("load_binary_input");
 
-        if(height_map.data[surrounding_position.y][surrounding_position.x] <= height_map.data[position.y][position.x])
+        auto height_map = aoc::make_halo_array2<uint8_t>(grid.size, 1, halo_height);
+        for (size_t y = 0; y < grid.size.y; y++)
         {
-            return false;
+            const auto source = grid.row(y);
+            std::copy(source.begin(), source.end(), height_map.row(y).begin());
         }
+        return height_map;
     }
 
-    return true;
-}
-
-std::vector<Point> get_low_points(const HeightMap& height_map)
-{
-    std::vector<Point> low_points;
-
-    for (int32_t y = 0; y < static_cast<int32_t>(height_map.data.size()); y++)
+    bool is_low_point(const HeightMap& height_map, const aoc::NeighbourOffsets<8>& surroundings, const size_t index)
     {
-        for (int32_t x = 0; x < static_cast<int32_t>(height_map.data[y].size()); x++)
+        const auto height = height_map[index];
+        for(const auto surrounding : surroundings)
         {
-            const auto heigh_map_position = Point{ x, y };
-            if (is_low_point(height_map, heigh_map_position))
+            if(height_map[index + surrounding] <= height)
             {
-                low_points.push_back(heigh_map_position);
+                return false;
             }
         }
-    }
 
-    return low_points;
-}
+        return true;
+    }
 
-// Part 2
-int32_t sum_risk_levels(const HeightMap& height_map, const std::vector<Point>& low_points)
-{
-    int32_t sum = 0;
-    for(const auto& low_point : low_points)
+    std::vector<size_t> append_indices(std::vector<size_t> lhs, std::vector<size_t> rhs)
     {
-        sum += height_map.data[low_point.y][low_point.x] + 1;
+        lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+        return lhs;
     }
-    return sum;
-}
 
+    std::vector<size_t> get_low_points(const HeightMap& height_map)
+    {
+        AOC_TRACE_SCOPE("get_low_points");
 
-int32_t solve_part_1(const std::vector<std::string>& values)
-{
-    auto height_map = parse_input(values);
-    auto low_points = get_low_points(height_map);
-    return sum_risk_levels(height_map, low_points);
-}
+        const auto surroundings = height_map.get_neighbour_offsets(aoc::adjacent_offsets);
 
-// Part 2
-size_t get_low_point_basin(const HeightMap& height_map, const Point& low_point)
-{
-    static const std::array surroundings = {
-        Point{ -1, 0 }, Point{ 1, 0 }, Point{ 0, -1 },Point{ 0, 1 },
-    };
+        return aoc::parallel_reduce(size_t{ 0 }, height_map.size.y, std::vector<size_t>{}, [&](const size_t row_begin, const size_t row_end)
+        {
+            std::vector<size_t> low_points;
+            for (size_t y = row_begin; y < row_end; y++)
+            {
+                const auto index_begin = height_map.get_index(0, y);
+                for (size_t index = index_begin; index < index_begin + height_map.size.x; index++)
+                {
+                    if (is_low_point(height_map, surroundings, index))
+                    {
+                        low_points.push_back(index);
+                    }
+                }
+            }
+            return low_points;
+        }, append_indices, 0, height_map.size.x);
+    }
+
+    // Part 2
+    int32_t sum_risk_levels(const HeightMap& height_map, const std::vector<size_t>& low_points)
+    {
+        int32_t sum = 0;
+        for(const auto low_point : low_points)
+        {
+            sum += height_map[low_point] + 1;
+        }
+        return sum;
+    }
 
-    std::vector<Point> processing_positions;
-    std::vector<Point> visited_positions;
 
-    auto is_visited_position = [&visited_positions](const Point& position)
+    int32_t solve_part_1(const HeightMap& height_map)
     {
-        return std::find_if(visited_positions.begin(), visited_positions.end(), [&](const Point& visited_position) {
-                return visited_position == position;
-			}) != visited_positions.end();
+        auto low_points = get_low_points(height_map);
+        return sum_risk_levels(height_map, low_points);
+    }
+
+    // Part 2
+    // Buffers of the basin search, kept in the part arena and reused for every basin.
+    struct BasinBuffers
+    {
+        std::pmr::vector<size_t> processing_positions;
+        std::pmr::vector<size_t> new_processing_positions;
+        std::pmr::vector<size_t> visited_positions;
+
+        explicit BasinBuffers(std::pmr::memory_resource* resource) :
+            processing_positions(resource),
+            new_processing_positions(resource),
+            visited_positions(resource)
+        {}
     };
 
-    auto process_positions = [&]()
+    size_t get_low_point_basin(const HeightMap& height_map, const aoc::NeighbourOffsets<4>& surroundings, const size_t low_point, BasinBuffers& buffers)
     {
-        std::vector<Point> new_processing_positions;
-        for(auto const processing_position : processing_positions)
+        auto& processing_positions = buffers.processing_positions;
+        auto& new_processing_positions = buffers.new_processing_positions;
+        auto& visited_positions = buffers.visited_positions;
+        processing_positions.clear();
+        visited_positions.clear();
+
+        auto is_visited_position = [&visited_positions](const size_t position)
         {
-            for (const auto& surrounding : surroundings)
-            {
-                const auto surrounding_position = processing_position + surrounding;
-                if (!is_inside_map(height_map, surrounding_position) || is_visited_position(surrounding_position))
-                {
-                    continue;
-                }
+            return std::find(visited_positions.begin(), visited_positions.end(), position) != visited_positions.end();
+        };
 
-                const auto surrounding_value = height_map.data[surrounding_position.y][surrounding_position.x];
-                if (surrounding_value == 9 || surrounding_value <= height_map.data[processing_position.y][processing_position.x])
+        auto process_positions = [&]()
+        {
+            new_processing_positions.clear();
+            for(auto const processing_position : processing_positions)
+            {
+                for (const auto surrounding : surroundings)
                 {
-                    continue;
+                    const auto surrounding_position = processing_position + surrounding;
+                    const auto surrounding_value = height_map[surrounding_position];
+                    if (surrounding_value >= 9 || surrounding_value <= height_map[processing_position] || is_visited_position(surrounding_position))
+                    {
+                        continue;
+                    }
+
+                    new_processing_positions.push_back(surrounding_position);
+                    visited_positions.push_back(surrounding_position);
                 }
-
-                new_processing_positions.push_back(surrounding_position);
-                visited_positions.push_back(surrounding_position);
             }
+            processing_positions.swap(new_processing_positions);
+        };
+
+        processing_positions.push_back(low_point);
+        visited_positions.push_back(low_point);
+        while(!processing_positions.empty())
+        {
+            process_positions();
         }
-        processing_positions = new_processing_positions;
-    };
 
-    processing_positions.push_back(low_point);
-    visited_positions.push_back(low_point);
-    while(!processing_positions.empty())
-    {
-        process_positions();
+        return visited_positions.size();
     }
 
-    return visited_positions.size();
-}
+    std::pmr::vector<size_t> get_basins(const HeightMap& height_map, const std::vector<size_t>& low_points)
+    {
+        AOC_TRACE_SCOPE("get_basins");
 
-std::vector<size_t> get_basins(const HeightMap& height_map, const std::vector<Point>& low_points)
-{
-    std::vector<size_t> basins;
-    for(const auto& low_point : low_points)
+        const auto surroundings = height_map.get_neighbour_offsets(aoc::orthogonal_offsets);
+        BasinBuffers buffers(aoc::get_part_memory_resource());
+        std::pmr::vector<size_t> basins(aoc::get_part_memory_resource());
+        basins.reserve(low_points.size());
+        for(const auto low_point : low_points)
+        {
+            basins.push_back(get_low_point_basin(height_map, surroundings, low_point, buffers));
+        }
+        return basins;
+    }
+
+    size_t accumulate_largest_basins(const std::pmr::vector<size_t>& basins, size_t count = 3)
     {
-        basins.push_back(get_low_point_basin(height_map, low_point));
+        const size_t max_count = basins.size() < count ? basins.size() : count;
+        return std::accumulate(basins.begin(), basins.begin() + max_count, size_t{ 1 }, std::multiplies<>());
     }
-    return basins;
-}
 
-size_t accumulate_largest_basins(const std::vector<size_t>& basins, size_t count = 3)
-{
-    const size_t max_count = basins.size() < count ? basins.size() : count;
-    return std::accumulate(basins.begin(), basins.begin() + max_count, size_t{ 1 }, std::multiplies<>());
-}
+    size_t solve_part_2(const HeightMap& height_map)
+    {
+        const auto low_points = get_low_points(height_map);
+        auto basins = get_basins(height_map, low_points);
+        std::sort(basins.begin(), basins.end(), std::greater<>());
+        return accumulate_largest_basins(basins);
+    }
 
-size_t solve_part_2(const std::vector<std::string>& values)
-{
-    const auto height_map = parse_input(values);
-    const auto low_points = get_low_points(height_map);
-    auto basins = get_basins(height_map, low_points);
-    std::sort(basins.begin(), basins.end(), std::greater<>());
-    return accumulate_largest_basins(basins);
-}
-
-int main() {
-    aoc::solve_puzzles(
-        aoc::read_input<9, std::string>(),
+    const bool registered = aoc::register_parsed_puzzle<9, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
+        parse_input,
         solve_part_1,
         solve_part_2
     );
+
+    const bool registered_binary = aoc::register_binary_input<9, std::string>(load_binary_input);
+
 }
\ No newline at end of file
@@ -1,20 +1,23 @@
 #include "utility.hpp"
 
-int64_t solve_part_1(const std::vector<std::string>& values)
+namespace day_1
 {
-    return 0;
-}
 
-int64_t solve_part_2(const std::vector<std::string>& values)
-{
-    return 0;
-}
+    int64_t solve_part_1(const std::vector<std::string>& values)
+    {
+        return 0;
+    }
 
-int main()
-{
-    aoc::solve_puzzles(
-        aoc::read_input<1, std::string>(),
+    int64_t solve_part_2(const std::vector<std::string>& values)
+    {
+        return 0;
+    }
+
+    const bool registered = aoc::register_puzzle<1, std::string>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{},
         solve_part_1,
         solve_part_2
     );
+
 }
\ No newline at end of file
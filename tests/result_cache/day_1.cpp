@@ -0,0 +1,20 @@
+#include "utility.hpp"
+#include "solve_counts.hpp"
+
+// Stand-in day 1 of test_result_cache, stamped with its own AOC_SOLVER_VERSION like the days of the solutions.
+namespace result_cache_test::day_1
+{
+
+    int64_t solve_part_1(const std::vector<int64_t>& values)
+    {
+        ++solve_counts[1];
+        return static_cast<int64_t>(values.size()) * 1;
+    }
+
+    const bool registered = aoc::register_puzzle<1, int64_t>(
+        AOC_SOLVER_VERSION,
+        aoc::input_format{ .skip_empty_lines = true },
+        solve_part_1
+    );
+
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef AOC_TESTS_RESULT_CACHE_SOLVE_COUNTS_HPP
+#define AOC_TESTS_RESULT_CACHE_SOLVE_COUNTS_HPP
+
+#include <array>
+#include <cstddef>
+
+namespace result_cache_test
+{
+
+    // Times the parts of each stand-in day were solved, by day. Cache hits do not solve.
+    inline std::array<size_t, 3> solve_counts = {};
+
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef AOC_TESTS_TEST_HPP
+#define AOC_TESTS_TEST_HPP
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstdlib>
+
+// AOC_CHECK(condition) for the test executables run by CTest. A failed check prints its expression and location and the test
+// keeps going; finish_tests() prints the summary and returns the exit code.
+#define AOC_CHECK(condition) aoc::test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+namespace aoc::test
+{
+
+    inline size_t& get_failure_count()
+    {
+        static size_t count = 0;
+        return count;
+    }
+
+    inline void check(const bool condition, const std::string_view expression, const char* file, const int line)
+    {
+        if (!condition)
+        {
+            std::cerr << file << ":" << line << ": Check failed: " << expression << "\n";
+            ++get_failure_count();
+        }
+    }
+
+    inline int finish_tests(const std::string_view name)
+    {
+        const auto failures = get_failure_count();
+        std::cout << name << ": " << (failures == 0 ? std::string("passed") : std::to_string(failures) + " checks failed") << "\n";
+        return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Positional count argument of a test, `fallback` if it is missing or invalid.
+    inline size_t get_count_argument(int argc, char** argv, const int index, const size_t fallback)
+    {
+        if (index >= argc)
+        {
+            return fallback;
+        }
+        const std::string_view text = argv[index];
+        size_t value = 0;
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size() ? value : fallback;
+    }
+
+}
+
+#endif
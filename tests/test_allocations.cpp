@@ -0,0 +1,83 @@
+#include "test.hpp"
+#include "allocations.hpp"
+#include "allocation_hooks.hpp"
+#include "task_scheduler.hpp"
+#include <memory>
+#include <vector>
+
+// Usage: test_allocations <threads>. Built with AOC_TRACK_ALLOCATIONS, checks that allocation_tracker counts the allocations
+// of the scheduler tasks a measurement spawns on a scheduler of that many threads, and nothing of other threads.
+namespace allocations_test
+{
+
+    [[gnu::noinline]] void allocate_bytes(const size_t size)
+    {
+        auto bytes = std::make_unique<unsigned char[]>(size);
+        bytes[0] = 1;
+    }
+
+    void test_tasks(aoc::task_scheduler& scheduler)
+    {
+        aoc::allocation_tracker tracker;
+        tracker.start();
+        allocate_bytes(1000);
+        {
+            aoc::task_group group(scheduler);
+            for (size_t i = 0; i < 100; i++)
+            {
+                group.spawn([&scheduler]()
+                {
+                    allocate_bytes(10);
+
+                    // Nested tasks count for the same measurement.
+                    aoc::task_group nested(scheduler);
+                    nested.spawn([]() { allocate_bytes(1); });
+                    nested.sync();
+                });
+            }
+            group.sync();
+        }
+        tracker.stop();
+
+        // Spawning allocates as well, so only the payloads are exact lower bounds.
+        const auto& statistics = tracker.get_statistics();
+        AOC_CHECK(statistics.count >= 1 + 100 * 2);
+        AOC_CHECK(statistics.bytes >= 1000 + 100 * (10 + 1));
+        AOC_CHECK(statistics.peak_bytes >= 1000);
+    }
+
+    void test_other_measurements(aoc::task_scheduler& scheduler)
+    {
+        aoc::allocation_tracker measured;
+        measured.start();
+        measured.stop();
+
+        // Tasks spawned outside of a measurement are not counted by the next one.
+        {
+            aoc::task_group group(scheduler);
+            for (size_t i = 0; i < 100; i++)
+            {
+                group.spawn([]() { allocate_bytes(100); });
+            }
+            group.sync();
+        }
+
+        measured.start();
+        measured.stop();
+        AOC_CHECK(measured.get_statistics().count == 0);
+        AOC_CHECK(measured.get_statistics().bytes == 0);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto thread_count = aoc::test::get_count_argument(argc, argv, 1, 4);
+    std::cout << "Threads: " << thread_count << "\n";
+
+    aoc::task_scheduler scheduler(thread_count);
+    allocations_test::test_tasks(scheduler);
+    allocations_test::test_other_measurements(scheduler);
+
+    return aoc::test::finish_tests("test_allocations");
+}
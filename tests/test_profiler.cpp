@@ -0,0 +1,83 @@
+#include "test.hpp"
+#include "utility.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <ctime>
+
+// Profiles a CPU-bound part through solve_part() with --profile set, and checks its collapsed stacks.
+// Built only with the AOC_ENABLE_PROFILER CMake option on Linux.
+namespace profiler_test
+{
+
+    double get_thread_cpu_seconds()
+    {
+        timespec time = {};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+    }
+
+    // Spins for 300 ms of CPU time, so the part gets samples on any machine.
+    [[gnu::noinline]] uint64_t spin_solver(const uint64_t& seed)
+    {
+        const auto end_time = get_thread_cpu_seconds() + 0.3;
+        uint64_t state = seed;
+        while (get_thread_cpu_seconds() < end_time)
+        {
+            for (size_t i = 0; i < 100000; i++)
+            {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+            }
+        }
+        return state;
+    }
+
+}
+
+int main()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "aoc_profiler_test";
+    std::filesystem::remove_all(directory);
+    aoc::get_options().profile_directory = directory.string();
+
+    const uint64_t seed = 1;
+    const auto output = aoc::solve_part(99, seed, 1, profiler_test::spin_solver);
+    std::cout << output.text;
+    AOC_CHECK(output.success);
+    AOC_CHECK(output.text.find("profile: ") != std::string::npos);
+
+    const auto filename = directory / "day_99_part_1.folded";
+    AOC_CHECK(std::filesystem::exists(filename));
+
+    // Every line is "frame;frame;frame count".
+    std::ifstream file(filename);
+    std::string line;
+    size_t samples = 0;
+    size_t solver_samples = 0;
+    bool lines_valid = true;
+    while (std::getline(file, line))
+    {
+        const auto separator = line.rfind(' ');
+        size_t count = 0;
+        if (separator == std::string::npos || std::from_chars(line.data() + separator + 1, line.data() + line.size(), count).ec != std::errc() || count == 0)
+        {
+            lines_valid = false;
+            continue;
+        }
+
+        samples += count;
+        if (line.find("profiler_test::spin_solver") != std::string::npos)
+        {
+            solver_samples += count;
+        }
+    }
+
+    std::cout << "Samples: " << samples << ", in the solver: " << solver_samples << "\n";
+    AOC_CHECK(lines_valid);
+    AOC_CHECK(samples > 0);
+    AOC_CHECK(solver_samples > 0);
+
+    std::filesystem::remove_all(directory);
+    return aoc::test::finish_tests("test_profiler");
+}
@@ -0,0 +1,85 @@
+#include "test.hpp"
+#include "utility.hpp"
+#include "result_cache/solve_counts.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// Runs two stand-in days with --cache, each compiled with the solver version CMake stamps into its own source file, and checks
+// that editing one of them invalidates only its own cached results. CMake passes the versions it computed for the days,
+// and the version day 2 has after an edit, as DAY_1_VERSION, DAY_2_VERSION and EDITED_DAY_2_VERSION.
+namespace result_cache_test
+{
+
+    const aoc::registered_puzzle* find_puzzle(const size_t day)
+    {
+        for (const auto& puzzle : aoc::get_puzzle_registry())
+        {
+            if (puzzle.day == day)
+            {
+                return &puzzle;
+            }
+        }
+        return nullptr;
+    }
+
+    // Solves or looks up a day, and returns its first result.
+    std::string run_day(const aoc::registered_puzzle& puzzle)
+    {
+        const auto result = aoc::run_puzzle(puzzle);
+        AOC_CHECK(result.succeeded() && result.parts.size() == 1);
+        return result.parts.empty() ? std::string() : result.parts.front().report.result;
+    }
+
+}
+
+int main()
+{
+    const auto directory = std::filesystem::temp_directory_path() / "aoc_result_cache_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const auto input_filename = directory / "input.txt";
+    std::ofstream(input_filename) << "1\n2\n3\n";
+
+    auto& options = aoc::get_options();
+    options.input_filename = input_filename.string();
+    options.cache_directory = (directory / "cache").string();
+    options.use_cache = true;
+
+    const auto* day_1 = result_cache_test::find_puzzle(1);
+    const auto* day_2 = result_cache_test::find_puzzle(2);
+    AOC_CHECK(day_1 != nullptr && day_2 != nullptr);
+    if (day_1 == nullptr || day_2 == nullptr)
+    {
+        return aoc::test::finish_tests("test_result_cache");
+    }
+
+    // Every day carries the version of its own file, whichever copy of the harness code the linker kept.
+    AOC_CHECK(day_1->version == DAY_1_VERSION);
+    AOC_CHECK(day_2->version == DAY_2_VERSION);
+    AOC_CHECK(day_1->version != day_2->version);
+    AOC_CHECK(std::string(EDITED_DAY_2_VERSION) != DAY_2_VERSION);
+
+    auto& counts = result_cache_test::solve_counts;
+    AOC_CHECK(result_cache_test::run_day(*day_1) == "3");
+    AOC_CHECK(result_cache_test::run_day(*day_2) == "6");
+    AOC_CHECK(counts[1] == 1 && counts[2] == 1);
+
+    // Unchanged days are served from the cache.
+    AOC_CHECK(result_cache_test::run_day(*day_1) == "3");
+    AOC_CHECK(result_cache_test::run_day(*day_2) == "6");
+    AOC_CHECK(counts[1] == 1 && counts[2] == 1);
+
+    // Rebuilding after an edit of day 2 solves day 2 again, day 1 is still cached.
+    auto edited_day_2 = *day_2;
+    edited_day_2.version = EDITED_DAY_2_VERSION;
+    AOC_CHECK(result_cache_test::run_day(*day_1) == "3");
+    AOC_CHECK(result_cache_test::run_day(edited_day_2) == "6");
+    AOC_CHECK(counts[1] == 1 && counts[2] == 2);
+
+    AOC_CHECK(result_cache_test::run_day(edited_day_2) == "6");
+    AOC_CHECK(counts[2] == 2);
+
+    std::filesystem::remove_all(directory);
+    return aoc::test::finish_tests("test_result_cache");
+}
@@ -0,0 +1,236 @@
+#include "test.hpp"
+#include "task_scheduler.hpp"
+#include "parallel.hpp"
+#include <atomic>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+// Usage: test_task_scheduler <threads>. Runs task groups on a scheduler of that many threads, and the parallel loops
+// with --grid-threads set to it.
+namespace task_scheduler_test
+{
+
+    void test_spawn_sync(aoc::task_scheduler& scheduler)
+    {
+        std::atomic<size_t> count = 0;
+        aoc::task_group group(scheduler);
+        for (size_t i = 0; i < 1000; i++)
+        {
+            group.spawn([&count]() { count.fetch_add(1, std::memory_order_relaxed); });
+        }
+        group.sync();
+        AOC_CHECK(count.load() == 1000);
+
+        // A group can be reused after sync().
+        group.spawn([&count]() { count.fetch_add(1, std::memory_order_relaxed); });
+        group.sync();
+        AOC_CHECK(count.load() == 1001);
+    }
+
+    // Every task spawns two children in its own group and syncs them, down to `depth`.
+    size_t count_leaves(aoc::task_scheduler& scheduler, const size_t depth)
+    {
+        if (depth == 0)
+        {
+            return 1;
+        }
+
+        size_t left = 0;
+        size_t right = 0;
+        aoc::task_group group(scheduler);
+        group.spawn([&]() { left = count_leaves(scheduler, depth - 1); });
+        group.spawn([&]() { right = count_leaves(scheduler, depth - 1); });
+        group.sync();
+        return left + right;
+    }
+
+    void test_nested_spawns(aoc::task_scheduler& scheduler)
+    {
+        AOC_CHECK(count_leaves(scheduler, 12) == 4096);
+    }
+
+    void test_exception(aoc::task_scheduler& scheduler)
+    {
+        std::atomic<size_t> count = 0;
+        bool caught = false;
+        {
+            aoc::task_group group(scheduler);
+            for (size_t i = 0; i < 100; i++)
+            {
+                group.spawn([&count, i]()
+                {
+                    count.fetch_add(1, std::memory_order_relaxed);
+                    if (i == 37)
+                    {
+                        throw std::runtime_error("task 37 failed");
+                    }
+                });
+            }
+
+            try
+            {
+                group.sync();
+            }
+            catch (const std::runtime_error& e)
+            {
+                caught = std::string(e.what()) == "task 37 failed";
+            }
+        }
+        AOC_CHECK(caught);
+        AOC_CHECK(count.load() == 100); // The other tasks still ran.
+
+        // The exception of a nested group reaches the sync() of the outer one.
+        caught = false;
+        aoc::task_group outer(scheduler);
+        outer.spawn([&scheduler]()
+        {
+            aoc::task_group inner(scheduler);
+            inner.spawn([]() { throw std::logic_error("inner"); });
+            inner.sync();
+        });
+        try
+        {
+            outer.sync();
+        }
+        catch (const std::logic_error&)
+        {
+            caught = true;
+        }
+        AOC_CHECK(caught);
+
+        // The scheduler keeps working after a failed group.
+        AOC_CHECK(count_leaves(scheduler, 6) == 64);
+    }
+
+    void test_parallel_for_chunks()
+    {
+        for (const auto grain : { size_t{ 1 }, size_t{ 7 }, size_t{ 1000 }, size_t{ 5000 } })
+        {
+            const size_t begin = 3;
+            const size_t end = 4003;
+            std::vector<std::atomic<uint32_t>> hits(end);
+            std::vector<std::atomic<uint32_t>> chunk_hits((end - begin + grain - 1) / grain);
+            std::atomic<bool> chunk_bounds_match = true;
+
+            const auto chunk_count = aoc::parallel_for_chunks(begin, end, grain, [&](const size_t chunk, const size_t chunk_begin, const size_t chunk_end)
+            {
+                if (chunk >= chunk_hits.size() || chunk_begin != begin + chunk * grain || chunk_end != std::min(end, chunk_begin + grain))
+                {
+                    chunk_bounds_match = false;
+                    return;
+                }
+                chunk_hits[chunk].fetch_add(1);
+                for (auto i = chunk_begin; i < chunk_end; i++)
+                {
+                    hits[i].fetch_add(1);
+                }
+            });
+
+            AOC_CHECK(chunk_count == chunk_hits.size());
+            AOC_CHECK(chunk_bounds_match.load());
+            bool every_chunk_once = true;
+            for (const auto& chunk_hit : chunk_hits)
+            {
+                every_chunk_once = every_chunk_once && chunk_hit.load() == 1;
+            }
+            AOC_CHECK(every_chunk_once);
+
+            bool every_index_once = true;
+            for (size_t i = 0; i < end; i++)
+            {
+                every_index_once = every_index_once && hits[i].load() == (i >= begin ? 1u : 0u);
+            }
+            AOC_CHECK(every_index_once);
+        }
+
+        size_t calls = 0;
+        AOC_CHECK(aoc::parallel_for_chunks(10, 10, 4, [&calls](size_t, size_t, size_t) { ++calls; }) == 0);
+        AOC_CHECK(calls == 0);
+    }
+
+    void test_parallel_reduce()
+    {
+        const size_t count = 100000;
+        uint64_t serial_sum = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            serial_sum += static_cast<uint64_t>(i) * i;
+        }
+
+        for (const auto grain : { size_t{ 0 }, size_t{ 1 }, size_t{ 7 }, size_t{ 1000 }, count * 2 })
+        {
+            const auto sum = aoc::parallel_reduce(size_t{ 0 }, count, uint64_t{ 0 }, [](const size_t begin, const size_t end)
+            {
+                uint64_t chunk_sum = 0;
+                for (auto i = begin; i < end; i++)
+                {
+                    chunk_sum += static_cast<uint64_t>(i) * i;
+                }
+                return chunk_sum;
+            }, [](const uint64_t lhs, const uint64_t rhs) { return lhs + rhs; }, grain);
+            AOC_CHECK(sum == serial_sum);
+        }
+
+        // Not commutative: chunks must be folded in order.
+        std::vector<size_t> serial_order(2000);
+        for (size_t i = 0; i < serial_order.size(); i++)
+        {
+            serial_order[i] = i;
+        }
+        const auto order = aoc::parallel_reduce(size_t{ 0 }, serial_order.size(), std::vector<size_t>{}, [](const size_t begin, const size_t end)
+        {
+            std::vector<size_t> indices;
+            for (auto i = begin; i < end; i++)
+            {
+                indices.push_back(i);
+            }
+            return indices;
+        }, [](std::vector<size_t> lhs, std::vector<size_t> rhs)
+        {
+            lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+            return lhs;
+        }, 13);
+        AOC_CHECK(order == serial_order);
+
+        AOC_CHECK(aoc::parallel_reduce(size_t{ 5 }, size_t{ 5 }, 42, [](size_t, size_t) { return 1; }, [](int lhs, int rhs) { return lhs + rhs; }) == 42);
+    }
+
+    void test_recursive_parallel_for(aoc::task_scheduler& scheduler)
+    {
+        std::vector<std::atomic<uint32_t>> hits(10000);
+        aoc::parallel_for(scheduler, 0, hits.size(), 64, [&hits](const size_t begin, const size_t end)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                hits[i].fetch_add(1);
+            }
+        });
+
+        bool every_index_once = true;
+        for (const auto& hit : hits)
+        {
+            every_index_once = every_index_once && hit.load() == 1;
+        }
+        AOC_CHECK(every_index_once);
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto thread_count = aoc::test::get_count_argument(argc, argv, 1, 4);
+    aoc::get_options().parallel_worker_count = thread_count;
+    std::cout << "Threads: " << thread_count << "\n";
+
+    aoc::task_scheduler scheduler(thread_count);
+    task_scheduler_test::test_spawn_sync(scheduler);
+    task_scheduler_test::test_nested_spawns(scheduler);
+    task_scheduler_test::test_exception(scheduler);
+    task_scheduler_test::test_recursive_parallel_for(scheduler);
+    task_scheduler_test::test_parallel_for_chunks();
+    task_scheduler_test::test_parallel_reduce();
+
+    return aoc::test::finish_tests("test_task_scheduler");
+}
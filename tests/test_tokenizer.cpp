@@ -0,0 +1,330 @@
+#include "test.hpp"
+#include "tokenizer.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <bit>
+
+// Compares the tokenizer against std::from_chars and memchr, with the vectorised matchers of this build and the scalar ones.
+namespace tokenizer_test
+{
+
+    struct parse_result
+    {
+        std::vector<int64_t> values;
+        bool success = true;
+
+        bool operator == (const parse_result&) const = default;
+    };
+
+    // Value of an optional '-' followed by digits, as std::from_chars parses it.
+    bool parse_reference_integer(const bool negative, const std::string_view digits, int64_t& value)
+    {
+        const auto text = (negative ? std::string("-") : std::string()) + std::string(digits);
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    bool is_digit(const char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    parse_result parse_reference_integers(const std::string_view text)
+    {
+        parse_result result;
+        size_t i = 0;
+        while (i < text.size())
+        {
+            if (!is_digit(text[i]))
+            {
+                ++i;
+                continue;
+            }
+
+            const auto begin = i;
+            while (i < text.size() && is_digit(text[i]))
+            {
+                ++i;
+            }
+
+            int64_t value = 0;
+            if (parse_reference_integer(begin != 0 && text[begin - 1] == '-', text.substr(begin, i - begin), value))
+            {
+                result.values.push_back(value);
+            }
+            else
+            {
+                result.success = false;
+            }
+        }
+        return result;
+    }
+
+    template<bool VVectorised>
+    parse_result parse_tokenizer_integers(const std::string_view text)
+    {
+        parse_result result;
+        result.success = aoc::detail::parse_integers<VVectorised>(text, result.values);
+        return result;
+    }
+
+    // Checks both tokenizer variants against the reference. The text is copied into its own allocation, so reads outside of it are caught by sanitizers.
+    void check_integers(const std::string& text)
+    {
+        const std::unique_ptr<char[]> copy(new char[text.size() + 1]);
+        std::memcpy(copy.get(), text.data(), text.size());
+        const std::string_view view(copy.get(), text.size());
+
+        const auto expected = parse_reference_integers(view);
+        const auto vectorised = parse_tokenizer_integers<true>(view);
+        const auto scalar = parse_tokenizer_integers<false>(view);
+        AOC_CHECK(vectorised == expected);
+        AOC_CHECK(scalar == expected);
+        if (vectorised != expected || scalar != expected)
+        {
+            std::cerr << "    text: \"" << text << "\"\n";
+        }
+    }
+
+    std::string make_digits(const size_t count, const char first = '1')
+    {
+        std::string digits(count, '0');
+        for (size_t i = 0; i < count; i++)
+        {
+            digits[i] = static_cast<char>('0' + (i + first - '0') % 10);
+        }
+        return digits;
+    }
+
+    void test_digit_runs()
+    {
+        for (size_t count = 1; count <= 20; count++)
+        {
+            const auto digits = make_digits(count);
+            check_integers(digits);
+            check_integers("-" + digits);
+            check_integers("+" + digits);
+            check_integers(" " + digits + "\n");
+            check_integers("a," + digits + ",b");
+            check_integers(std::string(count, '9'));
+            check_integers(std::string(count, '0'));
+            check_integers(std::string("-") + std::string(count, '9') + " ");
+        }
+    }
+
+    void test_limits()
+    {
+        check_integers("9223372036854775807");
+        check_integers("-9223372036854775808");
+        check_integers("9223372036854775808");
+        check_integers("-9223372036854775809");
+        check_integers("18446744073709551615");
+        check_integers("18446744073709551616");
+        check_integers("99999999999999999999");
+        check_integers("000000000000000000000000000042");
+        check_integers("-000000000000000000009223372036854775808");
+
+        std::vector<int64_t> values;
+        AOC_CHECK(aoc::parse_integers("-9223372036854775808", values));
+        AOC_CHECK(values.size() == 1 && values[0] == std::numeric_limits<int64_t>::min());
+        values.clear();
+        AOC_CHECK(!aoc::parse_integers("1 9223372036854775808 2", values));
+        AOC_CHECK((values == std::vector<int64_t>{ 1, 2 }));
+    }
+
+    void test_block_edges()
+    {
+        const auto block = aoc::tokenizer_block_size;
+        for (const auto size : { block - 1, block, block + 1, 2 * block - 1, 2 * block, 2 * block + 1 })
+        {
+            // A run ending exactly at the end of the text, which carries over the last block edge.
+            for (size_t count = 1; count <= 20 && count <= size; count++)
+            {
+                check_integers(std::string(size - count, ' ') + make_digits(count));
+                check_integers(std::string(size - count, '-') + make_digits(count, '7'));
+            }
+
+            // Runs crossing the block edge at every offset.
+            for (size_t count = 2; count <= 20; count++)
+            {
+                for (size_t before = 1; before < count; before++)
+                {
+                    auto text = std::string(block - before, ',') + make_digits(count, '3') + std::string(size > block ? size - block : 1, ',');
+                    check_integers(text);
+                }
+            }
+        }
+
+        check_integers(make_digits(64));
+        check_integers(std::string(63, ' ') + "7");
+        check_integers("7" + std::string(63, ' '));
+        check_integers(std::string(64, '-'));
+        check_integers("");
+    }
+
+    void test_random_text()
+    {
+        std::mt19937_64 engine(2021);
+        const std::string_view alphabet = "0123456789012345678901234567890123456789 ,\n-+-xA\x80\xff\t";
+        std::uniform_int_distribution<size_t> character(0, alphabet.size() - 1);
+        std::uniform_int_distribution<size_t> length(0, 300);
+
+        for (size_t i = 0; i < 20000; i++)
+        {
+            std::string text(length(engine), ' ');
+            for (auto& c : text)
+            {
+                c = alphabet[character(engine)];
+            }
+            check_integers(text);
+        }
+    }
+
+    bool parse_reference_token(std::string_view token, int64_t& value)
+    {
+        const auto negative = !token.empty() && token.front() == '-';
+        if (!token.empty() && (token.front() == '-' || token.front() == '+'))
+        {
+            token.remove_prefix(1);
+        }
+        if (token.empty())
+        {
+            return false;
+        }
+        for (const auto c : token)
+        {
+            if (!is_digit(c))
+            {
+                return false;
+            }
+        }
+        return parse_reference_integer(negative, token, value);
+    }
+
+    void check_token(const std::string& token)
+    {
+        const std::unique_ptr<char[]> copy(new char[token.size() + 1]);
+        std::memcpy(copy.get(), token.data(), token.size());
+        const std::string_view view(copy.get(), token.size());
+
+        int64_t expected = 0;
+        int64_t value = 0;
+        const auto expected_success = parse_reference_token(view, expected);
+        const auto success = aoc::parse_integer(view, value);
+        AOC_CHECK(success == expected_success);
+        AOC_CHECK(!success || value == expected);
+        if (success != expected_success || (success && value != expected))
+        {
+            std::cerr << "    token: \"" << token << "\"\n";
+        }
+    }
+
+    void test_parse_integer()
+    {
+        for (const auto* token : { "", "-", "+", "0", "-0", "+0", "+5", "-5", "--1", "+-1", "-+1", "12a", "a12", " 1", "1 ", "1-",
+            "9223372036854775807", "-9223372036854775808", "+9223372036854775807", "9223372036854775808", "-9223372036854775809",
+            "00000000000000000000000001", "1234567\x80", "12345678/", "12345678:" })
+        {
+            check_token(token);
+        }
+
+        for (size_t count = 1; count <= 20; count++)
+        {
+            check_token(make_digits(count));
+            check_token(std::string("-") + make_digits(count, '9'));
+            check_token(std::string("+") + make_digits(count, '5'));
+            check_token(std::string(count, '9'));
+            check_token(make_digits(count) + "x");
+            check_token(std::string("x") + make_digits(count));
+        }
+    }
+
+    std::vector<size_t> find_reference_bytes(const std::string_view text, const char byte)
+    {
+        std::vector<size_t> positions;
+        const char* position = text.data();
+        const char* end = text.data() + text.size();
+        while (position < end)
+        {
+            const auto* found = static_cast<const char*>(std::memchr(position, byte, static_cast<size_t>(end - position)));
+            if (found == nullptr)
+            {
+                break;
+            }
+            positions.push_back(static_cast<size_t>(found - text.data()));
+            position = found + 1;
+        }
+        return positions;
+    }
+
+    void check_bytes(const std::string& text, const char byte)
+    {
+        const std::unique_ptr<char[]> copy(new char[text.size() + 1]);
+        std::memcpy(copy.get(), text.data(), text.size());
+        const std::string_view view(copy.get(), text.size());
+
+        std::vector<size_t> positions;
+        aoc::for_each_byte(view, byte, [&positions](const size_t position) { positions.push_back(position); });
+        AOC_CHECK(positions == find_reference_bytes(view, byte));
+
+        // The scalar matcher gives the same masks as the vectorised one.
+        std::vector<size_t> scalar_positions;
+        aoc::detail::for_each_block_mask(view, [byte](const char* block) { return aoc::detail::match_byte<false>(block, byte); },
+            [&scalar_positions](const size_t offset, uint64_t mask)
+        {
+            for (; mask != 0; mask &= mask - 1)
+            {
+                scalar_positions.push_back(offset + static_cast<size_t>(std::countr_zero(mask)));
+            }
+        });
+        AOC_CHECK(scalar_positions == positions);
+    }
+
+    void test_for_each_byte()
+    {
+        const auto block = aoc::tokenizer_block_size;
+        check_bytes("", '\n');
+        check_bytes(std::string(block, '\n'), '\n');
+        check_bytes(std::string(block, 'a'), '\n');
+        check_bytes(std::string(block - 1, 'a') + "\n", '\n');
+        check_bytes("\n" + std::string(block, 'a') + "\n", '\n');
+        check_bytes(std::string(3 * block, '\x80'), '\x80');
+
+        std::mt19937_64 engine(25);
+        const std::string_view alphabet("ab\n\n,\x80\xff\0", 8);
+        std::uniform_int_distribution<size_t> character(0, alphabet.size() - 1);
+        std::uniform_int_distribution<size_t> length(0, 4 * block + 1);
+        for (size_t i = 0; i < 5000; i++)
+        {
+            std::string text(length(engine), ' ');
+            for (auto& c : text)
+            {
+                c = alphabet[character(engine)];
+            }
+            check_bytes(text, '\n');
+            check_bytes(text, '\xff');
+        }
+    }
+
+}
+
+int main()
+{
+    std::cout << "Tokenizer instruction set: " << aoc::get_tokenizer_instruction_set() << "\n";
+
+    tokenizer_test::test_digit_runs();
+    tokenizer_test::test_limits();
+    tokenizer_test::test_block_edges();
+    tokenizer_test::test_random_text();
+    tokenizer_test::test_parse_integer();
+    tokenizer_test::test_for_each_byte();
+
+    return aoc::test::finish_tests("test_tokenizer");
+}
@@ -0,0 +1,183 @@
+#include "array2_file.hpp"
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+#include <charconv>
+#include <cstdlib>
+#include <algorithm>
+
+// Converts text grids of digits, the inputs of days 9, 11 and 15, to binary Array2 files read with --binary.
+namespace converter
+{
+
+    inline constexpr size_t grid_days[] = { 9, 11, 15 };
+
+    // Parses lines of equal length of the digits 0-9 into a row-major grid. Returns false if the text is not such a grid.
+    bool parse_digit_grid(std::string_view text, aoc::Array2<uint8_t>& grid, std::string& error)
+    {
+        std::vector<std::string_view> lines;
+        aoc::for_each_line(text, [&lines](const std::string_view line)
+        {
+            if (!line.empty())
+            {
+                lines.push_back(line);
+            }
+        });
+
+        if (lines.empty())
+        {
+            error = "Input is empty.";
+            return false;
+        }
+
+        grid = aoc::make_array2<uint8_t>(aoc::Vector2s{ lines.front().size(), lines.size() });
+        for (size_t y = 0; y < lines.size(); y++)
+        {
+            if (lines[y].size() != grid.size.x)
+            {
+                error = "Invalid width of row " + std::to_string(y + 1) + ".";
+                return false;
+            }
+
+            auto row = grid.row(y);
+            for (size_t x = 0; x < row.size(); x++)
+            {
+                const auto character = lines[y][x];
+                if (character < '0' || character > '9')
+                {
+                    error = "Invalid character in row " + std::to_string(y + 1) + ".";
+                    return false;
+                }
+                row[x] = static_cast<uint8_t>(character - '0');
+            }
+        }
+
+        return true;
+    }
+
+    bool convert_file(const std::string& input_filename, const std::string& output_filename)
+    {
+        aoc::mapped_file input;
+        if (!input.open(input_filename))
+        {
+            std::cerr << "convert_grid: Failed to open input file: " << input_filename << "\n";
+            return false;
+        }
+
+        aoc::Array2<uint8_t> grid;
+        std::string error;
+        if (!parse_digit_grid(input.view(), grid, error))
+        {
+            std::cerr << "convert_grid: " << error << " " << input_filename << "\n";
+            return false;
+        }
+
+        if (!aoc::write_array2_file(output_filename, grid))
+        {
+            return false;
+        }
+
+        std::cout << input_filename << " -> " << output_filename << ": " << grid.size.x << " x " << grid.size.y << "\n";
+        return true;
+    }
+
+    void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " [options]\n"
+            "  --input <file>       Text grid to convert. Requires --output.\n"
+            "  --output <file>      Binary file to write.\n"
+            "  --input-dir <dir>    Convert day_<N>_input.txt of days 9, 11 and 15 to day_<N>_input.bin. Default: ../inputs.\n"
+            "  --day <day>          Only convert this day of the input directory, repeatable.\n"
+            "  --help               Print this message.\n";
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    std::string input_filename;
+    std::string output_filename;
+    std::string input_directory = "../inputs";
+    std::vector<size_t> days;
+
+    auto fail = [&](const std::string& message)
+    {
+        std::cerr << "convert_grid: " << message << "\n";
+        converter::print_usage(argv[0]);
+        std::exit(EXIT_FAILURE);
+    };
+
+    auto next_value = [&](int& index) -> std::string_view
+    {
+        if (index + 1 >= argc)
+        {
+            fail(std::string("Missing value for ") + argv[index]);
+        }
+        return argv[++index];
+    };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--input")
+        {
+            input_filename = next_value(i);
+        }
+        else if (argument == "--output")
+        {
+            output_filename = next_value(i);
+        }
+        else if (argument == "--input-dir")
+        {
+            input_directory = next_value(i);
+        }
+        else if (argument == "--day")
+        {
+            const auto text = next_value(i);
+            size_t day = 0;
+            auto parse_result = std::from_chars(text.data(), text.data() + text.size(), day);
+            if (parse_result.ec != std::errc() || parse_result.ptr != text.data() + text.size() ||
+                std::find(std::begin(converter::grid_days), std::end(converter::grid_days), day) == std::end(converter::grid_days))
+            {
+                fail("Day must be 9, 11 or 15.");
+            }
+            days.push_back(day);
+        }
+        else if (argument == "--help")
+        {
+            converter::print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        else
+        {
+            fail("Unknown argument: " + std::string(argument));
+        }
+    }
+
+    if (!input_filename.empty() || !output_filename.empty())
+    {
+        if (input_filename.empty() || output_filename.empty())
+        {
+            fail("--input and --output must be used together.");
+        }
+        return converter::convert_file(input_filename, output_filename) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (days.empty())
+    {
+        days.assign(std::begin(converter::grid_days), std::end(converter::grid_days));
+    }
+
+    bool success = true;
+    for (const auto day : days)
+    {
+        const auto base = (std::filesystem::path(input_directory) / ("day_" + std::to_string(day) + "_input")).string();
+        success = converter::convert_file(base + ".txt", base + ".bin") && success;
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
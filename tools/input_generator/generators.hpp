@@ -0,0 +1,670 @@
+#ifndef AOC_TOOLS_GENERATORS_HPP
+#define AOC_TOOLS_GENERATORS_HPP
+
+#include <random>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <cmath>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+
+// Writes valid puzzle inputs of any size, for scaling benchmarks.
+// A scale factor of 1 gives inputs of roughly the size of the real ones, input size grows linearly with the scale.
+namespace generator
+{
+
+    using random_engine = std::mt19937_64;
+
+    inline int64_t random_int(random_engine& engine, const int64_t min, const int64_t max)
+    {
+        return std::uniform_int_distribution<int64_t>(min, max)(engine);
+    }
+
+    inline size_t scaled_count(const size_t count, const double scale)
+    {
+        return std::max<size_t>(1, static_cast<size_t>(std::llround(static_cast<double>(count) * scale)));
+    }
+
+    // Side length of a square grid whose area grows linearly with the scale.
+    inline size_t scaled_side(const size_t side, const double scale)
+    {
+        return std::max<size_t>(1, static_cast<size_t>(std::llround(static_cast<double>(side) * std::sqrt(scale))));
+    }
+
+    // The real inputs have no trailing newline, which some days depend on.
+    class line_writer
+    {
+
+    public:
+
+        explicit line_writer(std::ostream& output) :
+            m_output(output)
+        {}
+
+        std::ostream& next_line()
+        {
+            if (!m_first)
+            {
+                m_output << '\n';
+            }
+            m_first = false;
+            return m_output;
+        }
+
+    private:
+
+        std::ostream& m_output;
+        bool m_first = true;
+
+    };
+
+    inline void write_digit_grid(std::ostream& output, const size_t side, random_engine& engine, const std::function<char(random_engine&)>& get_digit)
+    {
+        line_writer writer(output);
+        std::string row(side, '0');
+        for (size_t y = 0; y < side; y++)
+        {
+            for (auto& digit : row)
+            {
+                digit = get_digit(engine);
+            }
+            writer.next_line() << row;
+        }
+    }
+
+    inline void generate_day_1(std::ostream& output, const double scale, random_engine& engine)
+    {
+        line_writer writer(output);
+        int64_t depth = 100;
+        for (size_t i = 0; i < scaled_count(2000, scale); i++)
+        {
+            depth = std::max<int64_t>(0, depth + random_int(engine, -10, 20));
+            writer.next_line() << depth;
+        }
+    }
+
+    inline void generate_day_2(std::ostream& output, const double scale, random_engine& engine)
+    {
+        line_writer writer(output);
+        for (size_t i = 0; i < scaled_count(1000, scale); i++)
+        {
+            const auto command = random_int(engine, 0, 5);
+            const auto name = command < 3 ? "forward" : (command < 5 ? "down" : "up");
+            writer.next_line() << name << " " << random_int(engine, 1, 9);
+        }
+    }
+
+    inline void generate_day_3(std::ostream& output, const double scale, random_engine& engine)
+    {
+        // Part 2 filters until one value is left and fails if the remaining values agree on the filtered bit.
+        // The leading bits form every combination exactly once, which halves the values on each filter step.
+        // The count is therefore rounded to a power of two. Random trailing bits keep part 1 from being trivial.
+        size_t prefix_bit_count = 1;
+        while ((size_t{ 1 } << (prefix_bit_count + 1)) <= scaled_count(1000, scale) * 4 / 3)
+        {
+            ++prefix_bit_count;
+        }
+        const auto suffix_bit_count = prefix_bit_count < 10 ? 12 - prefix_bit_count : size_t{ 2 };
+        const auto bit_count = prefix_bit_count + suffix_bit_count;
+
+        std::vector<uint64_t> prefixes(size_t{ 1 } << prefix_bit_count);
+        std::iota(prefixes.begin(), prefixes.end(), uint64_t{ 0 });
+        std::shuffle(prefixes.begin(), prefixes.end(), engine);
+
+        line_writer writer(output);
+        std::string line(bit_count, '0');
+        for (const auto prefix : prefixes)
+        {
+            const auto suffix = static_cast<uint64_t>(random_int(engine, 0, (int64_t{ 1 } << suffix_bit_count) - 1));
+            const auto value = (prefix << suffix_bit_count) | suffix;
+            for (size_t i = 0; i < bit_count; i++)
+            {
+                line[i] = (value >> (bit_count - 1 - i)) & 1 ? '1' : '0';
+            }
+            writer.next_line() << line;
+        }
+    }
+
+    inline void generate_day_4(std::ostream& output, const double scale, random_engine& engine)
+    {
+        std::vector<int32_t> numbers(100);
+        std::iota(numbers.begin(), numbers.end(), 0);
+
+        std::shuffle(numbers.begin(), numbers.end(), engine);
+        for (size_t i = 0; i < numbers.size(); i++)
+        {
+            output << (i == 0 ? "" : ",") << numbers[i];
+        }
+        output << "\n";
+
+        // Every number is drawn eventually, so every board wins.
+        const auto board_count = scaled_count(100, scale);
+        for (size_t board = 0; board < board_count; board++)
+        {
+            std::shuffle(numbers.begin(), numbers.end(), engine);
+            output << "\n";
+            for (size_t y = 0; y < 5; y++)
+            {
+                for (size_t x = 0; x < 5; x++)
+                {
+                    const auto number = numbers[y * 5 + x];
+                    output << (x == 0 ? "" : " ") << (number < 10 ? " " : "") << number;
+                }
+                output << (board + 1 == board_count && y == 4 ? "" : "\n");
+            }
+        }
+    }
+
+    inline void generate_day_5(std::ostream& output, const double scale, random_engine& engine)
+    {
+        const auto size = static_cast<int64_t>(scaled_side(1000, scale));
+        line_writer writer(output);
+
+        for (size_t i = 0; i < scaled_count(500, scale); i++)
+        {
+            const auto from_x = random_int(engine, 0, size - 1);
+            const auto from_y = random_int(engine, 0, size - 1);
+            auto to_x = from_x;
+            auto to_y = from_y;
+
+            switch (random_int(engine, 0, 2))
+            {
+            case 0:
+            {
+                while (to_x == from_x)
+                {
+                    to_x = random_int(engine, 0, size - 1);
+                }
+            } break;
+            case 1:
+            {
+                while (to_y == from_y)
+                {
+                    to_y = random_int(engine, 0, size - 1);
+                }
+            } break;
+            default:
+            {
+                const auto direction_x = random_int(engine, 0, 1) == 0 ? -1 : 1;
+                const auto direction_y = random_int(engine, 0, 1) == 0 ? -1 : 1;
+                const auto max_length = std::min(
+                    direction_x < 0 ? from_x : size - 1 - from_x,
+                    direction_y < 0 ? from_y : size - 1 - from_y);
+                const auto length = max_length == 0 ? 0 : random_int(engine, 1, max_length);
+                to_x = from_x + direction_x * length;
+                to_y = from_y + direction_y * length;
+                if (length == 0)
+                {
+                    to_x = from_x == 0 ? 1 : 0;
+                }
+            } break;
+            }
+
+            writer.next_line() << from_x << "," << from_y << " -> " << to_x << "," << to_y;
+        }
+    }
+
+    inline void generate_day_6(std::ostream& output, const double scale, random_engine& engine)
+    {
+        for (size_t i = 0; i < scaled_count(300, scale); i++)
+        {
+            output << (i == 0 ? "" : ",") << random_int(engine, 1, 5);
+        }
+    }
+
+    inline void generate_day_7(std::ostream& output, const double scale, random_engine& engine)
+    {
+        // Positions are skewed towards zero, like the real input.
+        const auto max_position = static_cast<int64_t>(scaled_side(2000, scale));
+        for (size_t i = 0; i < scaled_count(1000, scale); i++)
+        {
+            const auto position = std::min(random_int(engine, 0, max_position), random_int(engine, 0, max_position));
+            output << (i == 0 ? "" : ",") << position;
+        }
+    }
+
+    inline void generate_day_8(std::ostream& output, const double scale, random_engine& engine)
+    {
+        static const std::array<std::string_view, 10> digit_segments = {
+            "abcefg", "cf", "acdeg", "acdfg", "bcdf", "abdfg", "abdefg", "acf", "abcdefg", "abcdfg"
+        };
+
+        line_writer writer(output);
+        std::string wiring = "abcdefg";
+
+        auto get_pattern = [&](const size_t digit)
+        {
+            std::string pattern;
+            for (const auto segment : digit_segments[digit])
+            {
+                pattern += wiring[segment - 'a'];
+            }
+            std::shuffle(pattern.begin(), pattern.end(), engine);
+            return pattern;
+        };
+
+        std::array<size_t, 10> digits;
+        std::iota(digits.begin(), digits.end(), size_t{ 0 });
+
+        for (size_t i = 0; i < scaled_count(200, scale); i++)
+        {
+            std::shuffle(wiring.begin(), wiring.end(), engine);
+            std::shuffle(digits.begin(), digits.end(), engine);
+
+            auto& line = writer.next_line();
+            for (const auto digit : digits)
+            {
+                line << get_pattern(digit) << " ";
+            }
+            line << "|";
+            for (size_t j = 0; j < 4; j++)
+            {
+                line << " " << get_pattern(static_cast<size_t>(random_int(engine, 0, 9)));
+            }
+        }
+    }
+
+    inline void generate_day_9(std::ostream& output, const double scale, random_engine& engine)
+    {
+        write_digit_grid(output, scaled_side(100, scale), engine, [](random_engine& engine)
+        {
+            // A quarter of the cells are basin walls.
+            return random_int(engine, 0, 3) == 0 ? '9' : static_cast<char>('0' + random_int(engine, 0, 8));
+        });
+    }
+
+    inline void generate_day_10(std::ostream& output, const double scale, random_engine& engine)
+    {
+        static const std::string_view openers = "([{<";
+        static const std::string_view closers = ")]}>";
+
+        line_writer writer(output);
+        std::string line;
+        std::vector<size_t> stack;
+
+        for (size_t i = 0; i < scaled_count(100, scale); i++)
+        {
+            // Every other line is incomplete, part 2 needs at least one of them.
+            const bool corrupt = i % 2 == 1;
+            const auto length = static_cast<size_t>(random_int(engine, 80, 110));
+            bool corrupted = false;
+            line.clear();
+            stack.clear();
+
+            while (line.size() < length || (corrupt ? !corrupted : stack.empty()))
+            {
+                if (stack.empty() || random_int(engine, 0, 99) < 55)
+                {
+                    stack.push_back(static_cast<size_t>(random_int(engine, 0, 3)));
+                    line += openers[stack.back()];
+                    continue;
+                }
+
+                if (corrupt && !corrupted && line.size() >= length / 2)
+                {
+                    const auto offset = static_cast<size_t>(random_int(engine, 1, 3));
+                    line += closers[(stack.back() + offset) % closers.size()];
+                    stack.pop_back();
+                    corrupted = true;
+                    continue;
+                }
+
+                line += closers[stack.back()];
+                stack.pop_back();
+            }
+
+            writer.next_line() << line;
+        }
+    }
+
+    // Returns true if every octopus flashes in the same step within the step limit.
+    inline bool is_synchronizing(std::vector<uint8_t> energy, const size_t side, const size_t max_steps)
+    {
+        std::vector<size_t> flashes;
+        for (size_t step = 0; step < max_steps; step++)
+        {
+            flashes.clear();
+            for (size_t i = 0; i < energy.size(); i++)
+            {
+                if (++energy[i] == 10)
+                {
+                    flashes.push_back(i);
+                }
+            }
+
+            for (size_t f = 0; f < flashes.size(); f++)
+            {
+                const auto x = static_cast<int64_t>(flashes[f] % side);
+                const auto y = static_cast<int64_t>(flashes[f] / side);
+                for (int64_t ny = y - 1; ny <= y + 1; ny++)
+                {
+                    for (int64_t nx = x - 1; nx <= x + 1; nx++)
+                    {
+                        if (nx < 0 || ny < 0 || nx >= static_cast<int64_t>(side) || ny >= static_cast<int64_t>(side))
+                        {
+                            continue;
+                        }
+                        const auto index = static_cast<size_t>(ny) * side + static_cast<size_t>(nx);
+                        if (++energy[index] == 10)
+                        {
+                            flashes.push_back(index);
+                        }
+                    }
+                }
+            }
+
+            for (const auto index : flashes)
+            {
+                energy[index] = 0;
+            }
+            if (flashes.size() == energy.size())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline void generate_day_11(std::ostream& output, const double scale, random_engine& engine)
+    {
+        // Part 2 only terminates once all octopuses flash at once, which many random grids never do.
+        // Grids are simulated and retried, energies of 3 and above make synchronization likely. A uniform grid always synchronizes.
+        const auto side = scaled_side(10, scale);
+        std::vector<uint8_t> energy(side * side);
+
+        bool found = false;
+        for (size_t attempt = 0; attempt < 16 && !found; attempt++)
+        {
+            for (auto& value : energy)
+            {
+                value = static_cast<uint8_t>(random_int(engine, 3, 9));
+            }
+            found = is_synchronizing(energy, side, 1000);
+        }
+        if (!found)
+        {
+            std::fill(energy.begin(), energy.end(), static_cast<uint8_t>(random_int(engine, 0, 9)));
+        }
+
+        line_writer writer(output);
+        std::string row(side, '0');
+        for (size_t y = 0; y < side; y++)
+        {
+            for (size_t x = 0; x < side; x++)
+            {
+                row[x] = static_cast<char>('0' + energy[y * side + x]);
+            }
+            writer.next_line() << row;
+        }
+    }
+
+    inline void generate_day_12(std::ostream& output, const double scale, random_engine& engine)
+    {
+        // Copies of one cave system share start and end. Paths can't cross between copies, so their count grows linearly.
+        static const std::array<std::pair<std::string_view, std::string_view>, 18> connections = { {
+            { "fs", "end" }, { "he", "DX" }, { "fs", "he" }, { "start", "DX" }, { "pj", "DX" }, { "end", "zg" },
+            { "zg", "sl" }, { "zg", "pj" }, { "pj", "he" }, { "RW", "he" }, { "fs", "DX" }, { "pj", "RW" },
+            { "zg", "RW" }, { "start", "pj" }, { "he", "WI" }, { "zg", "he" }, { "pj", "fs" }, { "start", "RW" }
+        } };
+
+        auto get_name = [](std::string_view name, size_t copy)
+        {
+            if (name == "start" || name == "end")
+            {
+                return std::string(name);
+            }
+
+            const char first_letter = std::isupper(static_cast<unsigned char>(name[0])) ? 'A' : 'a';
+            auto result = std::string(name);
+            do
+            {
+                result += static_cast<char>(first_letter + copy % 26);
+                copy /= 26;
+            } while (copy > 0);
+            return result;
+        };
+
+        line_writer writer(output);
+        std::vector<std::pair<std::string_view, std::string_view>> shuffled_connections(connections.begin(), connections.end());
+
+        for (size_t copy = 0; copy < scaled_count(8, scale); copy++)
+        {
+            std::shuffle(shuffled_connections.begin(), shuffled_connections.end(), engine);
+            for (const auto& [from, to] : shuffled_connections)
+            {
+                writer.next_line() << get_name(from, copy) << "-" << get_name(to, copy);
+            }
+        }
+    }
+
+    inline void generate_day_13(std::ostream& output, const double scale, random_engine& engine)
+    {
+        // Folds are always along the middle line, which never holds a dot. Larger scales add folds to grow the paper.
+        const auto extra_folds = scale > 1.0 ? static_cast<size_t>(std::llround(std::log(scale) / std::log(4.0))) : size_t{ 0 };
+
+        auto get_folds = [](size_t size, const size_t fold_count)
+        {
+            for (size_t i = 0; i < fold_count; i++)
+            {
+                size = size * 2 + 1;
+            }
+
+            std::vector<int64_t> folds;
+            for (size_t i = 0; i < fold_count; i++)
+            {
+                folds.push_back(static_cast<int64_t>(size / 2));
+                size /= 2;
+            }
+            return folds;
+        };
+
+        const auto x_folds = get_folds(40, 5 + extra_folds);
+        const auto y_folds = get_folds(6, 7 + extra_folds);
+        const auto width = x_folds.front() * 2 + 1;
+        const auto height = y_folds.front() * 2 + 1;
+
+        auto is_on_fold = [](int64_t value, const std::vector<int64_t>& folds)
+        {
+            for (const auto fold : folds)
+            {
+                if (value == fold)
+                {
+                    return true;
+                }
+                value = value > fold ? fold * 2 - value : value;
+            }
+            return false;
+        };
+
+        line_writer writer(output);
+
+        // The opposite corner gives the paper its full size.
+        writer.next_line() << width - 1 << "," << height - 1;
+        for (size_t i = 1; i < scaled_count(900, scale); i++)
+        {
+            int64_t x = 0, y = 0;
+            do
+            {
+                x = random_int(engine, 0, width - 1);
+                y = random_int(engine, 0, height - 1);
+            } while (is_on_fold(x, x_folds) || is_on_fold(y, y_folds));
+
+            writer.next_line() << x << "," << y;
+        }
+
+        writer.next_line();
+        for (size_t i = 0; i < std::max(x_folds.size(), y_folds.size()); i++)
+        {
+            if (i < x_folds.size())
+            {
+                writer.next_line() << "fold along x=" << x_folds[i];
+            }
+            if (i < y_folds.size())
+            {
+                writer.next_line() << "fold along y=" << y_folds[i];
+            }
+        }
+    }
+
+    inline void generate_day_14(std::ostream& output, const double scale, random_engine& engine)
+    {
+        static const std::string_view elements = "BCFHKNOPSV";
+
+        line_writer writer(output);
+
+        std::string polymer_template;
+        for (size_t i = 0; i < scaled_count(20, scale); i++)
+        {
+            polymer_template += elements[random_int(engine, 0, elements.size() - 1)];
+        }
+        writer.next_line() << polymer_template;
+        writer.next_line();
+
+        for (const auto first : elements)
+        {
+            for (const auto second : elements)
+            {
+                writer.next_line() << first << second << " -> " << elements[random_int(engine, 0, elements.size() - 1)];
+            }
+        }
+    }
+
+    inline void generate_day_15(std::ostream& output, const double scale, random_engine& engine)
+    {
+        write_digit_grid(output, scaled_side(100, scale), engine, [](random_engine& engine)
+        {
+            return static_cast<char>('1' + random_int(engine, 0, 8));
+        });
+    }
+
+    class bit_writer
+    {
+
+    public:
+
+        void write(const uint64_t value, const size_t bit_count)
+        {
+            for (size_t i = 0; i < bit_count; i++)
+            {
+                m_bits.push_back((value >> (bit_count - 1 - i)) & 1);
+            }
+        }
+
+        void append(const bit_writer& other)
+        {
+            m_bits.insert(m_bits.end(), other.m_bits.begin(), other.m_bits.end());
+        }
+
+        size_t size() const
+        {
+            return m_bits.size();
+        }
+
+        std::string to_hex() const
+        {
+            static const std::string_view hex_digits = "0123456789ABCDEF";
+
+            std::string result;
+            result.reserve((m_bits.size() + 3) / 4);
+            for (size_t i = 0; i < m_bits.size(); i += 4)
+            {
+                size_t digit = 0;
+                for (size_t j = i; j < i + 4; j++)
+                {
+                    digit = (digit << 1) | (j < m_bits.size() && m_bits[j] ? 1 : 0);
+                }
+                result += hex_digits[digit];
+            }
+            return result;
+        }
+
+    private:
+
+        std::vector<bool> m_bits;
+
+    };
+
+    inline void generate_packet(bit_writer& writer, const size_t bit_budget, random_engine& engine)
+    {
+        writer.write(static_cast<uint64_t>(random_int(engine, 0, 7)), 3);
+
+        if (bit_budget < 64)
+        {
+            writer.write(4, 3);
+            const auto group_count = static_cast<size_t>(random_int(engine, 1, 4));
+            for (size_t i = 0; i < group_count; i++)
+            {
+                writer.write(i + 1 < group_count ? 1 : 0, 1);
+                writer.write(static_cast<uint64_t>(random_int(engine, 0, 15)), 4);
+            }
+            return;
+        }
+
+        static const std::array<uint64_t, 7> operator_types = { 0, 1, 2, 3, 5, 6, 7 };
+        const auto packet_type = operator_types[random_int(engine, 0, operator_types.size() - 1)];
+        const auto sub_packet_count = packet_type >= 5 ? size_t{ 2 } : static_cast<size_t>(random_int(engine, 2, 8));
+
+        bit_writer sub_packets;
+        for (size_t i = 0; i < sub_packet_count; i++)
+        {
+            generate_packet(sub_packets, bit_budget / sub_packet_count, engine);
+        }
+
+        writer.write(packet_type, 3);
+        if (sub_packets.size() < (size_t{ 1 } << 15))
+        {
+            writer.write(0, 1);
+            writer.write(sub_packets.size(), 15);
+        }
+        else
+        {
+            writer.write(1, 1);
+            writer.write(sub_packet_count, 11);
+        }
+        writer.append(sub_packets);
+    }
+
+    inline void generate_day_16(std::ostream& output, const double scale, random_engine& engine)
+    {
+        bit_writer writer;
+        generate_packet(writer, scaled_count(1300 * 4, scale), engine);
+        output << writer.to_hex();
+    }
+
+    using generator_function = void(*)(std::ostream&, double, random_engine&);
+
+    inline const std::array<generator_function, 16> generators = {
+        generate_day_1, generate_day_2, generate_day_3, generate_day_4,
+        generate_day_5, generate_day_6, generate_day_7, generate_day_8,
+        generate_day_9, generate_day_10, generate_day_11, generate_day_12,
+        generate_day_13, generate_day_14, generate_day_15, generate_day_16
+    };
+
+    inline bool generate_input(const std::string& filename, const size_t day, const double scale, const uint64_t seed)
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "generate_input: Failed to open output file: " << filename << "\n";
+            return false;
+        }
+
+        // Every day gets its own sequence, so generating one day gives the same input as generating all of them.
+        random_engine engine(seed + day);
+        generators[day - 1](file, scale, engine);
+
+        return file.good();
+    }
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "generators.hpp"
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <filesystem>
+#include <charconv>
+#include <cstdlib>
+
+namespace generator
+{
+
+    void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " --output <path> [options]\n"
+            "  --day <day>          Day to generate, 1-16. Default: every day.\n"
+            "  --scale <factor>     Input size relative to the real inputs. Default: 1.\n"
+            "  --seed <seed>        Seed of the random generator. Default: 1.\n"
+            "  --output <path>      Output file of a single day, or directory of day_<N>_input.txt files.\n"
+            "  --help               Print this message.\n";
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t day = 0;
+    double scale = 1.0;
+    uint64_t seed = 1;
+    std::string output;
+
+    auto fail = [&](const std::string& message)
+    {
+        std::cerr << "generate_input: " << message << "\n";
+        generator::print_usage(argv[0]);
+        std::exit(EXIT_FAILURE);
+    };
+
+    auto next_value = [&](int& index) -> std::string_view
+    {
+        if (index + 1 >= argc)
+        {
+            fail(std::string("Missing value for ") + argv[index]);
+        }
+        return argv[++index];
+    };
+
+    auto parse_value = [&](int& index, auto& value)
+    {
+        const auto text = next_value(index);
+        auto parse_result = std::from_chars(text.data(), text.data() + text.size(), value);
+        if (parse_result.ec != std::errc() || parse_result.ptr != text.data() + text.size())
+        {
+            fail("Invalid value: " + std::string(text));
+        }
+    };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view argument = argv[i];
+
+        if (argument == "--day")
+        {
+            parse_value(i, day);
+            if (day < 1 || day > generator::generators.size())
+            {
+                fail("Day must be between 1 and " + std::to_string(generator::generators.size()) + ".");
+            }
+        }
+        else if (argument == "--scale")
+        {
+            parse_value(i, scale);
+            if (scale <= 0.0)
+            {
+                fail("Scale must be positive.");
+            }
+        }
+        else if (argument == "--seed")
+        {
+            parse_value(i, seed);
+        }
+        else if (argument == "--output")
+        {
+            output = next_value(i);
+        }
+        else if (argument == "--help")
+        {
+            generator::print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        else
+        {
+            fail("Unknown argument: " + std::string(argument));
+        }
+    }
+
+    if (output.empty())
+    {
+        fail("Missing --output.");
+    }
+
+    if (day != 0)
+    {
+        return generator::generate_input(output, day, scale, seed) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(output, error);
+    if (error)
+    {
+        std::cerr << "generate_input: Failed to create output directory: " << output << "\n";
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 1; i <= generator::generators.size(); i++)
+    {
+        const auto filename = (std::filesystem::path(output) / ("day_" + std::to_string(i) + "_input.txt")).string();
+        if (!generator::generate_input(filename, i, scale, seed))
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,271 @@
+#include "halo_array2.hpp"
+#include "benchmark.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <queue>
+#include <limits>
+#include <random>
+#include <charconv>
+#include <cstdlib>
+
+// Compares the throughput of Dijkstra and flood fill on a day 15 style risk map stored in every Array2 layout.
+namespace layout
+{
+
+    struct layout_options
+    {
+        size_t size = 2048;
+        size_t iterations = 3;
+        uint64_t seed = 1;
+    };
+
+    struct layout_result
+    {
+        uint64_t checksum = 0;
+        std::chrono::nanoseconds median = {};
+    };
+
+    // Risks 1-9, the same for every layout.
+    std::vector<uint8_t> generate_risks(const size_t size, const uint64_t seed)
+    {
+        std::mt19937_64 random(seed);
+        std::uniform_int_distribution<int> distribution(1, 9);
+
+        std::vector<uint8_t> risks(size * size);
+        for (auto& risk : risks)
+        {
+            risk = static_cast<uint8_t>(distribution(random));
+        }
+        risks.front() = 1;
+        return risks;
+    }
+
+    template<typename TLayout>
+    aoc::HaloArray2<uint8_t, TLayout> make_risk_map(const std::vector<uint8_t>& risks, const size_t size)
+    {
+        auto map = aoc::make_halo_array2<uint8_t, TLayout>(aoc::Vector2s{ size, size }, 1, uint8_t{ 0 });
+        for (size_t y = 0; y < size; y++)
+        {
+            for (size_t x = 0; x < size; x++)
+            {
+                map(x, y) = risks[y * size + x];
+            }
+        }
+        return map;
+    }
+
+    // Lowest total risk from the top left to the bottom right corner.
+    template<typename TLayout>
+    uint64_t run_dijkstra(aoc::HaloArray2<uint8_t, TLayout>& map)
+    {
+        struct queue_entry
+        {
+            uint32_t distance;
+            aoc::Vector2s position;
+
+            bool operator > (const queue_entry& rhs) const
+            {
+                return distance > rhs.distance;
+            }
+        };
+
+        // The halo holds distance 0, so it is never relaxed.
+        auto distances = aoc::make_halo_array2<uint32_t, TLayout>(map.size, 1, 0);
+        for (size_t y = 0; y < map.size.y; y++)
+        {
+            for (size_t x = 0; x < map.size.x; x++)
+            {
+                distances(x, y) = std::numeric_limits<uint32_t>::max();
+            }
+        }
+
+        std::priority_queue<queue_entry, std::vector<queue_entry>, std::greater<>> queue;
+        distances(0, 0) = 0;
+        queue.push({ 0, { 0, 0 } });
+
+        const auto end = aoc::Vector2s{ map.size.x - 1, map.size.y - 1 };
+        while (!queue.empty())
+        {
+            const auto current = queue.top();
+            queue.pop();
+
+            if (current.position == end)
+            {
+                return current.distance;
+            }
+            if (current.distance > distances(current.position.x, current.position.y))
+            {
+                continue;
+            }
+
+            aoc::for_each_neighbour(map, current.position, aoc::orthogonal_offsets, [&](const aoc::Vector2s neighbour, const uint8_t risk)
+            {
+                auto& distance = distances(neighbour.x, neighbour.y);
+                const auto new_distance = current.distance + risk;
+                if (new_distance < distance)
+                {
+                    distance = new_distance;
+                    queue.push({ new_distance, neighbour });
+                }
+            });
+        }
+
+        return 0;
+    }
+
+    // Number of cells reachable from the top left corner without crossing a risk of 9.
+    template<typename TLayout>
+    uint64_t run_flood_fill(aoc::HaloArray2<uint8_t, TLayout>& map)
+    {
+        // The halo counts as visited.
+        auto visited = aoc::make_halo_array2<uint8_t, TLayout>(map.size, 1, 1);
+
+        std::vector<aoc::Vector2s> stack = { { 0, 0 } };
+        visited(0, 0) = 1;
+        uint64_t count = 0;
+
+        while (!stack.empty())
+        {
+            const auto position = stack.back();
+            stack.pop_back();
+            ++count;
+
+            aoc::for_each_neighbour(visited, position, aoc::orthogonal_offsets, [&](const aoc::Vector2s neighbour, uint8_t& is_visited)
+            {
+                if (is_visited == 0 && map(neighbour.x, neighbour.y) < 9)
+                {
+                    is_visited = 1;
+                    stack.push_back(neighbour);
+                }
+            });
+        }
+
+        return count;
+    }
+
+    template<typename TFunction>
+    layout_result measure(const layout_options& options, TFunction&& function)
+    {
+        layout_result result;
+        std::vector<std::chrono::nanoseconds> samples;
+
+        for (size_t i = 0; i < options.iterations; i++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            result.checksum = function();
+            samples.push_back(std::chrono::steady_clock::now() - start);
+        }
+
+        result.median = aoc::calculate_timing_statistics(std::move(samples)).median;
+        return result;
+    }
+
+    void print_result(const std::string_view algorithm, const std::string_view layout_name, const layout_options& options, const layout_result& result)
+    {
+        const auto cells = static_cast<double>(options.size * options.size);
+        const auto seconds = std::chrono::duration<double>(result.median).count();
+
+        std::cout << std::left << std::setw(12) << algorithm << std::setw(14) << layout_name << std::right <<
+            std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms" <<
+            std::setw(12) << std::setprecision(2) << (seconds > 0.0 ? cells / seconds / 1000000.0 : 0.0) << " Mcells/s" <<
+            "    result: " << result.checksum << "\n";
+    }
+
+    template<typename TLayout>
+    void run_layout(const std::string_view layout_name, const layout_options& options, const std::vector<uint8_t>& risks)
+    {
+        auto map = make_risk_map<TLayout>(risks, options.size);
+
+        print_result("dijkstra", layout_name, options, measure(options, [&]() { return run_dijkstra(map); }));
+        print_result("flood_fill", layout_name, options, measure(options, [&]() { return run_flood_fill(map); }));
+    }
+
+    void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " [options]\n"
+            "  --size <cells>       Width and height of the map. Default: 2048.\n"
+            "  --iterations <count> Timed iterations per layout. Default: 3.\n"
+            "  --seed <seed>        Seed of the random map. Default: 1.\n"
+            "  --help               Print this message.\n";
+    }
+
+    layout_options parse_layout_options(int argc, char** argv)
+    {
+        layout_options result;
+
+        auto fail = [&](const std::string& message)
+        {
+            std::cerr << "parse_layout_options: " << message << "\n";
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        };
+
+        auto parse_value = [&](int& index, auto& value)
+        {
+            if (index + 1 >= argc)
+            {
+                fail(std::string("Missing value for ") + argv[index]);
+            }
+            const std::string_view text = argv[++index];
+            auto parse_result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (parse_result.ec != std::errc() || parse_result.ptr != text.data() + text.size())
+            {
+                fail("Invalid value: " + std::string(text));
+            }
+        };
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--size")
+            {
+                parse_value(i, result.size);
+            }
+            else if (argument == "--iterations")
+            {
+                parse_value(i, result.iterations);
+            }
+            else if (argument == "--seed")
+            {
+                parse_value(i, result.seed);
+            }
+            else if (argument == "--help")
+            {
+                print_usage(argv[0]);
+                std::exit(EXIT_SUCCESS);
+            }
+            else
+            {
+                fail("Unknown argument: " + std::string(argument));
+            }
+        }
+
+        if (result.size < 2 || result.size > 65536 || result.iterations == 0)
+        {
+            fail("Size must be between 2 and 65536 and iterations at least 1.");
+        }
+
+        return result;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = layout::parse_layout_options(argc, argv);
+    const auto risks = layout::generate_risks(options.size, options.seed);
+
+    std::cout << "Map of " << options.size << " x " << options.size << ", median of " << options.iterations << " iterations.\n";
+
+    layout::run_layout<aoc::RowMajorLayout>("row_major", options, risks);
+    layout::run_layout<aoc::TiledLayout<16>>("tiled_16", options, risks);
+    layout::run_layout<aoc::TiledLayout<64>>("tiled_64", options, risks);
+    layout::run_layout<aoc::MortonLayout>("morton", options, risks);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,416 @@
+#include "utility.hpp"
+#include "allocation_hooks.hpp"
+#include "generators.hpp"
+#include <cmath>
+#include <map>
+
+// Runs every day on generated inputs of geometrically growing size and fits how time and memory grow with it.
+namespace scaling
+{
+
+    struct scaling_options
+    {
+        std::vector<size_t> days; // Empty runs every day.
+        size_t steps = 4;
+        double base_scale = 1.0;
+        double factor = 4.0;
+        uint64_t seed = 1;
+        size_t iterations = 3;
+        double max_seconds = 5.0; // Larger sizes of a day are skipped once a part is slower than this.
+        std::string work_directory = "../inputs_scaling";
+        std::string export_filename;
+        std::string baseline_filename;
+        double tolerance = 0.3;
+    };
+
+    struct size_sample
+    {
+        double scale = 0.0;
+        std::chrono::nanoseconds median = {};
+        uint64_t peak_bytes = 0;
+    };
+
+    struct part_scaling
+    {
+        size_t day = 0;
+        size_t part = 0;
+        std::vector<size_sample> samples;
+        double time_exponent = 0.0;
+        double memory_exponent = 0.0;
+    };
+
+    // Time and memory exponents per day and part.
+    using baseline_exponents = std::map<std::pair<size_t, size_t>, std::pair<double, double>>;
+
+    // Least squares slope of log(value) over log(scale), the empirical exponent of value ~ scale^k.
+    double fit_exponent(const std::vector<size_sample>& samples, double(*get_value)(const size_sample&))
+    {
+        if (samples.size() < 2)
+        {
+            return 0.0;
+        }
+
+        double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+        for (const auto& sample : samples)
+        {
+            const auto x = std::log(sample.scale);
+            const auto y = std::log(std::max(get_value(sample), 1.0));
+            sum_x += x;
+            sum_y += y;
+            sum_xx += x * x;
+            sum_xy += x * y;
+        }
+
+        const auto count = static_cast<double>(samples.size());
+        const auto denominator = count * sum_xx - sum_x * sum_x;
+        return denominator == 0.0 ? 0.0 : (count * sum_xy - sum_x * sum_y) / denominator;
+    }
+
+    double get_sample_time(const size_sample& sample)
+    {
+        return static_cast<double>(sample.median.count());
+    }
+
+    double get_sample_memory(const size_sample& sample)
+    {
+        return static_cast<double>(sample.peak_bytes);
+    }
+
+    std::vector<part_scaling> run_scaling(const scaling_options& options)
+    {
+        auto& harness_options = aoc::get_options();
+        harness_options.benchmark = true;
+        harness_options.warmup_iterations = 1;
+        harness_options.iterations = options.iterations;
+
+        auto puzzles = aoc::get_puzzle_registry();
+        std::sort(puzzles.begin(), puzzles.end(), [](const auto& lhs, const auto& rhs) { return lhs.day < rhs.day; });
+        puzzles.erase(std::remove_if(puzzles.begin(), puzzles.end(), [&](const auto& puzzle)
+        {
+            return puzzle.day > generator::generators.size() ||
+                (!options.days.empty() && std::find(options.days.begin(), options.days.end(), puzzle.day) == options.days.end());
+        }), puzzles.end());
+
+        std::vector<part_scaling> results;
+        std::map<size_t, bool> stopped_days;
+
+        for (size_t step = 0; step < options.steps; step++)
+        {
+            const auto scale = options.base_scale * std::pow(options.factor, static_cast<double>(step));
+            const auto directory = std::filesystem::path(options.work_directory) / ("scale_" + std::to_string(step));
+            std::filesystem::create_directories(directory);
+            harness_options.input_directory = directory.string();
+
+            for (const auto& puzzle : puzzles)
+            {
+                if (stopped_days[puzzle.day])
+                {
+                    continue;
+                }
+
+                const auto filename = aoc::get_input_filename(puzzle.day);
+                if (!generator::generate_input(filename, puzzle.day, scale, options.seed))
+                {
+                    stopped_days[puzzle.day] = true;
+                    continue;
+                }
+
+                const auto input = aoc::read_puzzle_input(puzzle);
+                if (!input.is_valid())
+                {
+                    std::cerr << "Day " << puzzle.day << " at scale " << scale << ": Failed to read input. " << input.error << "\n";
+                    stopped_days[puzzle.day] = true;
+                    continue;
+                }
+
+                for (size_t part_index = 0; part_index < puzzle.parts.size(); part_index++)
+                {
+                    const auto output = aoc::run_part(puzzle, part_index, input);
+                    if (!output.success)
+                    {
+                        std::cerr << "Day " << puzzle.day << " at scale " << scale << ": " << output.error << "\n";
+                        stopped_days[puzzle.day] = true;
+                        continue;
+                    }
+
+                    auto it = std::find_if(results.begin(), results.end(), [&](const auto& result)
+                    {
+                        return result.day == puzzle.day && result.part == output.part;
+                    });
+                    if (it == results.end())
+                    {
+                        part_scaling scaling;
+                        scaling.day = puzzle.day;
+                        scaling.part = output.part;
+                        it = results.insert(results.end(), std::move(scaling));
+                    }
+
+                    const auto peak_bytes = output.report.allocations ? output.report.allocations->peak_bytes : uint64_t{ 0 };
+                    it->samples.push_back({ scale, output.report.timing.median, peak_bytes });
+
+                    std::cout << "Day " << puzzle.day << " part " << output.part << " at scale " << scale << ": " <<
+                        aoc::time_to_string(output.report.timing.median) << ", peak " << peak_bytes << " bytes\n";
+
+                    if (std::chrono::duration<double>(output.report.timing.median).count() > options.max_seconds)
+                    {
+                        stopped_days[puzzle.day] = true;
+                    }
+                }
+
+                std::filesystem::remove(filename);
+            }
+        }
+
+        for (auto& result : results)
+        {
+            result.time_exponent = fit_exponent(result.samples, get_sample_time);
+            result.memory_exponent = fit_exponent(result.samples, get_sample_memory);
+        }
+        return results;
+    }
+
+    bool write_scaling_csv(const std::string& filename, const std::vector<part_scaling>& results)
+    {
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "write_scaling_csv: Failed to open file: " << filename << "\n";
+            return false;
+        }
+
+        file << "day,part,scale,median_ns,peak_bytes,time_exponent,memory_exponent\n";
+        for (const auto& result : results)
+        {
+            for (const auto& sample : result.samples)
+            {
+                file << result.day << "," << result.part << "," << sample.scale << "," << sample.median.count() << "," <<
+                    sample.peak_bytes << "," << result.time_exponent << "," << result.memory_exponent << "\n";
+            }
+        }
+        return file.good();
+    }
+
+    bool read_scaling_baseline(const std::string& filename, baseline_exponents& baseline)
+    {
+        std::ifstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "read_scaling_baseline: Failed to open file: " << filename << "\n";
+            return false;
+        }
+
+        std::string line;
+        std::getline(file, line); // Header.
+
+        while (std::getline(file, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+
+            std::vector<std::string> columns;
+            std::stringstream ss(line);
+            std::string column;
+            while (std::getline(ss, column, ','))
+            {
+                columns.push_back(column);
+            }
+
+            size_t day = 0;
+            size_t part = 0;
+            double time_exponent = 0.0;
+            double memory_exponent = 0.0;
+            if (columns.size() != 7 || !aoc::parse_csv_number(columns[0], day) || !aoc::parse_csv_number(columns[1], part) ||
+                !aoc::parse_csv_number(columns[5], time_exponent) || !aoc::parse_csv_number(columns[6], memory_exponent))
+            {
+                std::cerr << "read_scaling_baseline: Invalid baseline row: " << line << "\n";
+                return false;
+            }
+
+            baseline[{ day, part }] = { time_exponent, memory_exponent };
+        }
+
+        return true;
+    }
+
+    // Prints the fitted exponents. Returns false if any of them grew more than the tolerance compared to the baseline.
+    bool print_scaling_results(const std::vector<part_scaling>& results, const baseline_exponents* baseline, const double tolerance)
+    {
+        bool passed = true;
+
+        std::cout << "\nFitted exponents, time ~ scale^k:\n";
+        for (const auto& result : results)
+        {
+            std::cout << "Day " << result.day << " part " << result.part << ": time k=" << result.time_exponent <<
+                ", memory k=" << result.memory_exponent << " (" << result.samples.size() << " sizes)";
+
+            if (baseline != nullptr)
+            {
+                const auto it = baseline->find({ result.day, result.part });
+                if (it == baseline->end())
+                {
+                    std::cout << ", no baseline";
+                }
+                else
+                {
+                    const auto [baseline_time, baseline_memory] = it->second;
+                    std::cout << ", baseline time k=" << baseline_time << ", memory k=" << baseline_memory;
+
+                    if (result.time_exponent > baseline_time + tolerance || result.memory_exponent > baseline_memory + tolerance)
+                    {
+                        std::cout << "    COMPLEXITY REGRESSION";
+                        passed = false;
+                    }
+                }
+            }
+            std::cout << "\n";
+        }
+
+        return passed;
+    }
+
+    void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " [options]\n"
+            "  --day <day>          Day to run, repeatable. Default: every day.\n"
+            "  --steps <count>      Number of sizes. Default: 4.\n"
+            "  --scale <factor>     Scale of the smallest size. Default: 1.\n"
+            "  --factor <factor>    Growth between sizes. Default: 4.\n"
+            "  --seed <seed>        Seed of the input generators. Default: 1.\n"
+            "  --iterations <count> Timed iterations per size. Default: 3.\n"
+            "  --max-time <seconds> Skip larger sizes of a day once a part takes longer. Default: 5.\n"
+            "  --work-dir <dir>     Directory of the generated inputs. Default: ../inputs_scaling.\n"
+            "  --export <file>      Write samples and exponents to a .csv file.\n"
+            "  --baseline <file>    Compare exponents to an exported .csv file and fail if they grew.\n"
+            "  --tolerance <k>      Allowed growth of an exponent compared to the baseline. Default: 0.3.\n"
+            "  --help               Print this message.\n";
+    }
+
+    scaling_options parse_scaling_options(int argc, char** argv)
+    {
+        scaling_options result;
+
+        auto fail = [&](const std::string& message)
+        {
+            std::cerr << "parse_scaling_options: " << message << "\n";
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        };
+
+        auto next_value = [&](int& index) -> std::string_view
+        {
+            if (index + 1 >= argc)
+            {
+                fail(std::string("Missing value for ") + argv[index]);
+            }
+            return argv[++index];
+        };
+
+        auto parse_value = [&](int& index, auto& value)
+        {
+            const auto text = next_value(index);
+            auto parse_result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (parse_result.ec != std::errc() || parse_result.ptr != text.data() + text.size())
+            {
+                fail("Invalid value: " + std::string(text));
+            }
+        };
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--day")
+            {
+                size_t day = 0;
+                parse_value(i, day);
+                result.days.push_back(day);
+            }
+            else if (argument == "--steps")
+            {
+                parse_value(i, result.steps);
+            }
+            else if (argument == "--scale")
+            {
+                parse_value(i, result.base_scale);
+            }
+            else if (argument == "--factor")
+            {
+                parse_value(i, result.factor);
+            }
+            else if (argument == "--seed")
+            {
+                parse_value(i, result.seed);
+            }
+            else if (argument == "--iterations")
+            {
+                parse_value(i, result.iterations);
+            }
+            else if (argument == "--max-time")
+            {
+                parse_value(i, result.max_seconds);
+            }
+            else if (argument == "--work-dir")
+            {
+                result.work_directory = next_value(i);
+            }
+            else if (argument == "--export")
+            {
+                result.export_filename = next_value(i);
+            }
+            else if (argument == "--baseline")
+            {
+                result.baseline_filename = next_value(i);
+            }
+            else if (argument == "--tolerance")
+            {
+                parse_value(i, result.tolerance);
+            }
+            else if (argument == "--help")
+            {
+                print_usage(argv[0]);
+                std::exit(EXIT_SUCCESS);
+            }
+            else
+            {
+                fail("Unknown argument: " + std::string(argument));
+            }
+        }
+
+        if (result.steps < 2 || result.iterations == 0 || result.base_scale <= 0.0 || result.factor <= 1.0)
+        {
+            fail("Needs at least 2 steps, 1 iteration, a positive scale and a factor above 1.");
+        }
+
+        return result;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = scaling::parse_scaling_options(argc, argv);
+
+    // Read before the run, so a broken baseline fails without waiting for every size to be solved.
+    scaling::baseline_exponents baseline;
+    const bool has_baseline = !options.baseline_filename.empty();
+    if (has_baseline && !scaling::read_scaling_baseline(options.baseline_filename, baseline))
+    {
+        return EXIT_FAILURE;
+    }
+
+    const auto results = scaling::run_scaling(options);
+
+    bool success = !results.empty();
+
+    if (!options.export_filename.empty())
+    {
+        success = scaling::write_scaling_csv(options.export_filename, results) && success;
+    }
+
+    success = scaling::print_scaling_results(results, has_baseline ? &baseline : nullptr, options.tolerance) && success;
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,225 @@
+#include "task_scheduler.hpp"
+#include "benchmark.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstdlib>
+#include <algorithm>
+
+// Measures the overhead of the work-stealing scheduler with very fine-grained tasks:
+// a recursive Fibonacci that spawns a task for every call, and a parallel_for with one index per chunk.
+namespace scheduler
+{
+
+    struct scheduler_options
+    {
+        size_t thread_count = 0;
+        size_t fibonacci = 25;
+        size_t loop_size = 1000000;
+        size_t iterations = 5;
+    };
+
+    struct scheduler_result
+    {
+        uint64_t checksum = 0;
+        size_t tasks = 0;
+        std::chrono::nanoseconds median = {};
+    };
+
+    uint64_t fibonacci_serial(const size_t n)
+    {
+        return n < 2 ? n : fibonacci_serial(n - 1) + fibonacci_serial(n - 2);
+    }
+
+    // One task per call, except for the leaves.
+    uint64_t fibonacci_tasks(aoc::task_scheduler& scheduler, const size_t n)
+    {
+        if (n < 2)
+        {
+            return n;
+        }
+
+        uint64_t lhs = 0;
+        aoc::task_group group(scheduler);
+        group.spawn([&scheduler, &lhs, n]() { lhs = fibonacci_tasks(scheduler, n - 1); });
+        const auto rhs = fibonacci_tasks(scheduler, n - 2);
+        group.sync();
+        return lhs + rhs;
+    }
+
+    // Number of calls of fibonacci_tasks with n >= 2, which is the number of spawned tasks.
+    size_t count_fibonacci_tasks(const size_t n)
+    {
+        return n < 2 ? 0 : 1 + count_fibonacci_tasks(n - 1) + count_fibonacci_tasks(n - 2);
+    }
+
+    uint64_t mix(uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    template<typename TFunction>
+    scheduler_result measure(const scheduler_options& options, const size_t tasks, TFunction&& function)
+    {
+        scheduler_result result;
+        result.tasks = tasks;
+        std::vector<std::chrono::nanoseconds> samples;
+
+        for (size_t i = 0; i < options.iterations; i++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            result.checksum = function();
+            samples.push_back(std::chrono::steady_clock::now() - start);
+        }
+
+        result.median = aoc::calculate_timing_statistics(std::move(samples)).median;
+        return result;
+    }
+
+    // Prints the time per task, and the overhead per task compared to the serial baseline.
+    void print_result(const std::string_view name, const scheduler_result& result, const scheduler_result& baseline)
+    {
+        const auto milliseconds = std::chrono::duration<double, std::milli>(result.median).count();
+        const auto tasks = static_cast<double>(std::max(result.tasks, size_t{ 1 }));
+        const auto per_task = static_cast<double>(result.median.count()) / tasks;
+        const auto overhead = static_cast<double>(result.median.count() - baseline.median.count()) / tasks;
+
+        std::cout << std::left << std::setw(16) << name << std::right <<
+            std::setw(12) << std::fixed << std::setprecision(3) << milliseconds << " ms" <<
+            std::setw(12) << result.tasks << " tasks" <<
+            std::setw(10) << std::setprecision(1) << per_task << " ns/task" <<
+            std::setw(10) << overhead << " ns overhead" <<
+            "    result: " << result.checksum << "\n";
+    }
+
+    void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " [options]\n"
+            "  --threads <count>    Threads of the scheduler, including the main thread. 0 uses all processors. Default: 0.\n"
+            "  --fibonacci <n>      Fibonacci number computed with one task per call. Default: 25.\n"
+            "  --loop-size <count>  Indices of the parallel_for, one per chunk. Default: 1000000.\n"
+            "  --iterations <count> Timed iterations per benchmark. Default: 5.\n"
+            "  --help               Print this message.\n";
+    }
+
+    scheduler_options parse_scheduler_options(int argc, char** argv)
+    {
+        scheduler_options result;
+
+        auto fail = [&](const std::string& message)
+        {
+            std::cerr << "parse_scheduler_options: " << message << "\n";
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        };
+
+        auto parse_value = [&](int& index, auto& value)
+        {
+            if (index + 1 >= argc)
+            {
+                fail(std::string("Missing value for ") + argv[index]);
+            }
+            const std::string_view text = argv[++index];
+            auto parse_result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (parse_result.ec != std::errc() || parse_result.ptr != text.data() + text.size())
+            {
+                fail("Invalid value: " + std::string(text));
+            }
+        };
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--threads")
+            {
+                parse_value(i, result.thread_count);
+            }
+            else if (argument == "--fibonacci")
+            {
+                parse_value(i, result.fibonacci);
+            }
+            else if (argument == "--loop-size")
+            {
+                parse_value(i, result.loop_size);
+            }
+            else if (argument == "--iterations")
+            {
+                parse_value(i, result.iterations);
+            }
+            else if (argument == "--help")
+            {
+                print_usage(argv[0]);
+                std::exit(EXIT_SUCCESS);
+            }
+            else
+            {
+                fail("Unknown argument: " + std::string(argument));
+            }
+        }
+
+        if (result.fibonacci > 40 || result.iterations == 0)
+        {
+            fail("Fibonacci must be at most 40 and iterations at least 1.");
+        }
+        if (result.thread_count == 0)
+        {
+            result.thread_count = aoc::get_default_worker_count();
+        }
+
+        return result;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = scheduler::parse_scheduler_options(argc, argv);
+    aoc::task_scheduler task_scheduler(options.thread_count);
+
+    std::cout << task_scheduler.get_thread_count() << " threads, median of " << options.iterations << " iterations.\n";
+
+    const auto fibonacci_tasks = scheduler::count_fibonacci_tasks(options.fibonacci);
+    const auto fibonacci_serial = scheduler::measure(options, fibonacci_tasks, [&]() { return scheduler::fibonacci_serial(options.fibonacci); });
+    scheduler::print_result("fib_serial", fibonacci_serial, fibonacci_serial);
+    scheduler::print_result("fib_tasks", scheduler::measure(options, fibonacci_tasks, [&]()
+    {
+        return scheduler::fibonacci_tasks(task_scheduler, options.fibonacci);
+    }), fibonacci_serial);
+
+    // Chunks of one index, so parallel_for spawns loop_size - 1 tasks.
+    const auto loop_tasks = options.loop_size > 0 ? options.loop_size - 1 : 0;
+    const auto loop_serial = scheduler::measure(options, loop_tasks, [&]()
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < options.loop_size; i++)
+        {
+            sum += scheduler::mix(i);
+        }
+        return sum;
+    });
+    scheduler::print_result("loop_serial", loop_serial, loop_serial);
+    scheduler::print_result("parallel_for", scheduler::measure(options, loop_tasks, [&]()
+    {
+        std::atomic<uint64_t> sum = 0;
+        aoc::parallel_for(task_scheduler, 0, options.loop_size, 1, [&sum](const size_t begin, const size_t end)
+        {
+            uint64_t chunk_sum = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                chunk_sum += scheduler::mix(i);
+            }
+            sum.fetch_add(chunk_sum, std::memory_order_relaxed);
+        });
+        return sum.load();
+    }), loop_serial);
+
+    return EXIT_SUCCESS;
+}
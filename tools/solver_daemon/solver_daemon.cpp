@@ -0,0 +1,651 @@
+#include "utility.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <set>
+#include <future>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// Resident process that links every day and solves requests sent over a Unix domain socket, without the startup of a day_N process.
+// Requests are lines of text, answered in order on the same connection:
+//   solve <day> <part> file <path>        Solves a part with the input file at path.
+//   solve <day> <part> data <bytes>       Solves a part with the input sent in the next <bytes> bytes.
+//   batch <count>                         Followed by <count> solve requests, solved in parallel.
+//   stats                                 Counters of the daemon.
+//   quit                                  Closes the connection.
+// A solve is answered with "ok <read_ns> <solve_ns> <bytes>\n<result>\n" or "error <message>\n",
+// stats with "stats <bytes>\n<lines of name and value>".
+namespace solver_daemon
+{
+
+    struct daemon_options
+    {
+        std::string socket_path = "/tmp/aoc_daemon.sock";
+        size_t worker_count = 0; // Zero uses every logical processor.
+        size_t max_input_bytes = 64 * 1024 * 1024;
+    };
+
+    struct solve_request
+    {
+        size_t day = 0;
+        size_t part = 0;
+        std::string filename; // Empty if the input was sent with the request.
+        std::shared_ptr<const std::string> text;
+        std::string error; // Set if the request is malformed, it is answered without solving then.
+    };
+
+    struct solve_response
+    {
+        bool success = false;
+        std::string result;
+        std::string error;
+        std::chrono::nanoseconds read_time = {}; // Reading and parsing the input.
+        std::chrono::nanoseconds solve_time = {};
+    };
+
+    struct day_statistics
+    {
+        uint64_t requests = 0;
+        uint64_t failures = 0;
+        std::chrono::nanoseconds read_time = {};
+        std::chrono::nanoseconds solve_time = {};
+    };
+
+    class daemon_statistics
+    {
+
+    public:
+
+        void add_connection()
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_connections;
+            ++m_active_connections;
+        }
+
+        void remove_connection()
+        {
+            std::lock_guard lock(m_mutex);
+            --m_active_connections;
+        }
+
+        void add_batch()
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_batches;
+        }
+
+        // Requests for a day that is not linked in.
+        void add_rejected_request()
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_rejected_requests;
+        }
+
+        void add_request(const size_t day, const solve_response& response)
+        {
+            std::lock_guard lock(m_mutex);
+            auto& statistics = m_days[day];
+            ++statistics.requests;
+            statistics.failures += response.success ? 0 : 1;
+            statistics.read_time += response.read_time;
+            statistics.solve_time += response.solve_time;
+        }
+
+        std::string to_string(const size_t worker_count) const
+        {
+            std::lock_guard lock(m_mutex);
+
+            uint64_t requests = m_rejected_requests;
+            uint64_t failures = m_rejected_requests;
+            for (const auto& [day, statistics] : m_days)
+            {
+                requests += statistics.requests;
+                failures += statistics.failures;
+            }
+
+            std::stringstream text;
+            text << "uptime_ms " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start_time).count() << "\n";
+            text << "workers " << worker_count << "\n";
+            text << "connections_active " << m_active_connections << "\n";
+            text << "connections_total " << m_connections << "\n";
+            text << "batches " << m_batches << "\n";
+            text << "requests " << requests << "\n";
+            text << "failures " << failures << "\n";
+            for (const auto& [day, statistics] : m_days)
+            {
+                text << "day_" << day << " requests " << statistics.requests << " failures " << statistics.failures <<
+                    " read_ns " << statistics.read_time.count() << " solve_ns " << statistics.solve_time.count() << "\n";
+            }
+            return text.str();
+        }
+
+    private:
+
+        mutable std::mutex m_mutex;
+        std::chrono::steady_clock::time_point m_start_time = std::chrono::steady_clock::now();
+        uint64_t m_connections = 0;
+        uint64_t m_active_connections = 0;
+        uint64_t m_batches = 0;
+        uint64_t m_rejected_requests = 0;
+        std::map<size_t, day_statistics> m_days;
+
+    };
+
+    // Solves requests on a pool of workers, with every registered day.
+    class solver_service
+    {
+
+    public:
+
+        explicit solver_service(const size_t worker_count) :
+            m_pool(worker_count)
+        {
+            for (const auto& puzzle : aoc::get_puzzle_registry())
+            {
+                m_puzzles[puzzle.day] = &puzzle;
+            }
+        }
+
+        size_t get_worker_count() const
+        {
+            return m_pool.get_worker_count();
+        }
+
+        daemon_statistics& get_statistics()
+        {
+            return m_statistics;
+        }
+
+        std::future<solve_response> submit(solve_request request)
+        {
+            auto promise = std::make_shared<std::promise<solve_response>>();
+            auto future = promise->get_future();
+            m_pool.push([this, promise, request = std::move(request)]()
+            {
+                auto response = solve(request);
+                if (m_puzzles.contains(request.day))
+                {
+                    m_statistics.add_request(request.day, response);
+                }
+                else
+                {
+                    m_statistics.add_rejected_request();
+                }
+                promise->set_value(std::move(response));
+            });
+            return future;
+        }
+
+    private:
+
+        solve_response solve(const solve_request& request) const
+        {
+            solve_response response;
+            if (!request.error.empty())
+            {
+                response.error = request.error;
+                return response;
+            }
+
+            const auto it = m_puzzles.find(request.day);
+            if (it == m_puzzles.end())
+            {
+                response.error = "Day " + std::to_string(request.day) + " is not available.";
+                return response;
+            }
+
+            const auto& puzzle = *it->second;
+            if (request.part == 0 || request.part > puzzle.parts.size())
+            {
+                response.error = "Day " + std::to_string(request.day) + " has no part " + std::to_string(request.part) + ".";
+                return response;
+            }
+
+            const auto input = request.text ? puzzle.read_text(request.text) : puzzle.read(request.filename);
+            response.read_time = input.read_time + input.parse_time.value_or(std::chrono::nanoseconds{ 0 });
+            if (input.is_empty)
+            {
+                response.error = "Input data is empty.";
+                return response;
+            }
+            if (!input.error.empty())
+            {
+                response.error = input.error;
+                return response;
+            }
+
+            const auto output = puzzle.parts[request.part - 1](input);
+            response.success = output.success;
+            response.result = output.report.result;
+            response.error = output.error;
+            response.solve_time = output.report.timing.median;
+            return response;
+        }
+
+        std::map<size_t, const aoc::registered_puzzle*> m_puzzles;
+        aoc::thread_pool m_pool;
+        daemon_statistics m_statistics;
+
+    };
+
+#if !defined(_WIN32)
+
+    // Buffered reads of lines and byte blocks from a socket.
+    class socket_reader
+    {
+
+    public:
+
+        explicit socket_reader(const int socket) :
+            m_socket(socket)
+        {}
+
+        bool read_line(std::string& line)
+        {
+            while (true)
+            {
+                const auto end = m_buffer.find('\n', m_position);
+                if (end != std::string::npos)
+                {
+                    line.assign(m_buffer, m_position, end - m_position);
+                    m_position = end + 1;
+                    if (!line.empty() && line.back() == '\r')
+                    {
+                        line.pop_back();
+                    }
+                    return true;
+                }
+                if (!fill())
+                {
+                    return false;
+                }
+            }
+        }
+
+        bool read_bytes(const size_t count, std::string& bytes)
+        {
+            while (m_buffer.size() - m_position < count)
+            {
+                if (!fill())
+                {
+                    return false;
+                }
+            }
+            bytes.assign(m_buffer, m_position, count);
+            m_position += count;
+            return true;
+        }
+
+    private:
+
+        bool fill()
+        {
+            m_buffer.erase(0, m_position);
+            m_position = 0;
+
+            char chunk[64 * 1024];
+            const auto count = ::recv(m_socket, chunk, sizeof(chunk), 0);
+            if (count <= 0)
+            {
+                return false;
+            }
+            m_buffer.append(chunk, static_cast<size_t>(count));
+            return true;
+        }
+
+        int m_socket;
+        std::string m_buffer;
+        size_t m_position = 0;
+
+    };
+
+    bool send_all(const int socket, const std::string_view bytes)
+    {
+        size_t sent = 0;
+        while (sent < bytes.size())
+        {
+            const auto count = ::send(socket, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+            if (count <= 0)
+            {
+                return false;
+            }
+            sent += static_cast<size_t>(count);
+        }
+        return true;
+    }
+
+    std::string format_response(const solve_response& response)
+    {
+        if (!response.success)
+        {
+            auto message = response.error.empty() ? std::string("Failed to solve.") : response.error;
+            std::replace(message.begin(), message.end(), '\n', ' ');
+            return "error " + message + "\n";
+        }
+
+        return "ok " + std::to_string(response.read_time.count()) + " " + std::to_string(response.solve_time.count()) + " " +
+            std::to_string(response.result.size()) + "\n" + response.result + "\n";
+    }
+
+    bool parse_count(const std::string_view text, size_t& value)
+    {
+        const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    std::vector<std::string_view> split_words(const std::string_view line)
+    {
+        std::vector<std::string_view> words;
+        aoc::for_each_word(line, [&words](const std::string_view word)
+        {
+            if (!word.empty())
+            {
+                words.push_back(word);
+            }
+        });
+        return words;
+    }
+
+    // Parses "solve <day> <part> file <path>" or "solve <day> <part> data <bytes>", reading the data that follows.
+    // Returns false if the connection can not continue, malformed requests only set request.error.
+    bool read_solve_request(socket_reader& reader, const std::string& line, const daemon_options& options, solve_request& request)
+    {
+        const auto words = split_words(line);
+        if (words.size() < 5 || words[0] != "solve" || !parse_count(words[1], request.day) || !parse_count(words[2], request.part))
+        {
+            request.error = "Expected: solve <day> <part> file <path> | data <bytes>";
+            return true;
+        }
+
+        if (words[3] == "file")
+        {
+            // The path is the rest of the line, it may contain spaces.
+            request.filename = std::string(line.substr(static_cast<size_t>(words[4].data() - line.data())));
+            return true;
+        }
+
+        size_t byte_count = 0;
+        if (words[3] != "data" || words.size() != 5 || !parse_count(words[4], byte_count))
+        {
+            request.error = "Expected: solve <day> <part> file <path> | data <bytes>";
+            return true;
+        }
+        if (byte_count > options.max_input_bytes)
+        {
+            // The data can not be skipped safely without reading it, so the connection ends.
+            return false;
+        }
+
+        auto text = std::make_shared<std::string>();
+        if (!reader.read_bytes(byte_count, *text))
+        {
+            return false;
+        }
+        request.text = std::move(text);
+        return true;
+    }
+
+    void serve_connection(const int socket, solver_service& service, const daemon_options& options)
+    {
+        socket_reader reader(socket);
+        std::string line;
+
+        while (reader.read_line(line))
+        {
+            const auto words = split_words(line);
+            if (words.empty())
+            {
+                continue;
+            }
+
+            std::string response;
+            if (words[0] == "solve")
+            {
+                solve_request request;
+                if (!read_solve_request(reader, line, options, request))
+                {
+                    send_all(socket, "error Input is too large or incomplete.\n");
+                    break;
+                }
+                response = format_response(service.submit(std::move(request)).get());
+            }
+            else if (words[0] == "batch")
+            {
+                size_t count = 0;
+                if (words.size() != 2 || !parse_count(words[1], count))
+                {
+                    response = "error Expected: batch <count>\n";
+                }
+                else
+                {
+                    service.get_statistics().add_batch();
+
+                    // Every request is submitted before the first answer is awaited, so the batch runs in parallel.
+                    std::vector<std::future<solve_response>> responses;
+                    bool is_complete = true;
+                    for (size_t i = 0; i < count && is_complete; i++)
+                    {
+                        solve_request request;
+                        is_complete = reader.read_line(line) && read_solve_request(reader, line, options, request);
+                        if (is_complete)
+                        {
+                            responses.push_back(service.submit(std::move(request)));
+                        }
+                    }
+
+                    for (auto& future : responses)
+                    {
+                        response += format_response(future.get());
+                    }
+                    if (!is_complete)
+                    {
+                        send_all(socket, response + "error Input is too large or incomplete.\n");
+                        break;
+                    }
+                }
+            }
+            else if (words[0] == "stats")
+            {
+                const auto text = service.get_statistics().to_string(service.get_worker_count());
+                response = "stats " + std::to_string(text.size()) + "\n" + text;
+            }
+            else if (words[0] == "quit")
+            {
+                break;
+            }
+            else
+            {
+                response = "error Unknown request: " + std::string(words[0]) + "\n";
+            }
+
+            if (!send_all(socket, response))
+            {
+                break;
+            }
+        }
+    }
+
+    std::atomic<bool> stop_requested = false;
+
+    extern "C" void handle_stop_signal(int)
+    {
+        stop_requested = true;
+    }
+
+    int run_daemon(const daemon_options& options)
+    {
+        const auto worker_count = options.worker_count == 0 ? aoc::get_default_worker_count() : options.worker_count;
+        solver_service service(worker_count);
+
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (options.socket_path.size() >= sizeof(address.sun_path))
+        {
+            std::cerr << "aoc_daemon: Socket path is too long: " << options.socket_path << "\n";
+            return EXIT_FAILURE;
+        }
+        std::memcpy(address.sun_path, options.socket_path.c_str(), options.socket_path.size() + 1);
+
+        const int listen_socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        ::unlink(options.socket_path.c_str());
+        if (listen_socket < 0 || ::bind(listen_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listen_socket, 64) != 0)
+        {
+            std::cerr << "aoc_daemon: Failed to listen on " << options.socket_path << ": " << std::strerror(errno) << "\n";
+            return EXIT_FAILURE;
+        }
+
+        std::signal(SIGINT, handle_stop_signal);
+        std::signal(SIGTERM, handle_stop_signal);
+        std::cout << "aoc_daemon: Listening on " << options.socket_path << " with " << worker_count << " workers and " <<
+            aoc::get_puzzle_registry().size() << " days." << std::endl;
+
+        std::mutex connections_mutex;
+        std::condition_variable connections_condition;
+        std::set<int> connections;
+
+        while (!stop_requested)
+        {
+            pollfd poll_socket{ listen_socket, POLLIN, 0 };
+            if (::poll(&poll_socket, 1, 200) <= 0)
+            {
+                continue;
+            }
+
+            const int socket = ::accept(listen_socket, nullptr, nullptr);
+            if (socket < 0)
+            {
+                continue;
+            }
+
+            {
+                std::lock_guard lock(connections_mutex);
+                connections.insert(socket);
+            }
+            service.get_statistics().add_connection();
+
+            std::thread([&, socket]()
+            {
+                serve_connection(socket, service, options);
+                service.get_statistics().remove_connection();
+                // Notified under the lock, run_daemon may return as soon as the set is empty.
+                std::lock_guard lock(connections_mutex);
+                connections.erase(socket);
+                ::close(socket);
+                connections_condition.notify_all();
+            }).detach();
+        }
+
+        ::close(listen_socket);
+        ::unlink(options.socket_path.c_str());
+
+        // Unblocks the connections waiting for requests, and waits for them to finish the requests in flight.
+        std::unique_lock lock(connections_mutex);
+        for (const auto socket : connections)
+        {
+            ::shutdown(socket, SHUT_RDWR);
+        }
+        connections_condition.wait(lock, [&connections]() { return connections.empty(); });
+
+        std::cout << "aoc_daemon: Stopped.\n" << service.get_statistics().to_string(worker_count);
+        return EXIT_SUCCESS;
+    }
+
+#endif
+
+    void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " [options]\n"
+            "  --socket <path>      Unix domain socket to listen on. Default: /tmp/aoc_daemon.sock.\n"
+            "  --workers <count>    Threads solving requests. Default: all processors.\n"
+            "  --max-input <KiB>    Largest input accepted with a request. Default: 65536.\n"
+            "  --help               Print this message.\n";
+    }
+
+    daemon_options parse_daemon_options(int argc, char** argv)
+    {
+        daemon_options result;
+
+        auto fail = [&](const std::string& message)
+        {
+            std::cerr << "parse_daemon_options: " << message << "\n";
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        };
+
+        auto next_value = [&](int& index) -> std::string_view
+        {
+            if (index + 1 >= argc)
+            {
+                fail(std::string("Missing value for ") + argv[index]);
+            }
+            return argv[++index];
+        };
+
+        auto next_count = [&](int& index) -> size_t
+        {
+            const auto value = next_value(index);
+            size_t count = 0;
+            auto parse_result = std::from_chars(value.data(), value.data() + value.size(), count);
+            if (parse_result.ec != std::errc() || parse_result.ptr != value.data() + value.size())
+            {
+                fail("Invalid count: " + std::string(value));
+            }
+            return count;
+        };
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--socket")
+            {
+                result.socket_path = next_value(i);
+            }
+            else if (argument == "--workers")
+            {
+                result.worker_count = next_count(i);
+            }
+            else if (argument == "--max-input")
+            {
+                result.max_input_bytes = next_count(i) * 1024;
+            }
+            else if (argument == "--help")
+            {
+                print_usage(argv[0]);
+                std::exit(EXIT_SUCCESS);
+            }
+            else
+            {
+                fail("Unknown argument: " + std::string(argument));
+            }
+        }
+
+        return result;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = solver_daemon::parse_daemon_options(argc, argv);
+
+#if defined(_WIN32)
+    (void)options;
+    std::cerr << "aoc_daemon: Unix domain sockets are not supported on this platform.\n";
+    return EXIT_FAILURE;
+#else
+    return solver_daemon::run_daemon(options);
+#endif
+}
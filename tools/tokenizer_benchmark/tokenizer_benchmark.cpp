@@ -0,0 +1,289 @@
+#include "tokenizer.hpp"
+#include "mapped_file.hpp"
+#include "benchmark.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <charconv>
+#include <cstdlib>
+
+// Measures the throughput of integer input parsing: the std::getline and std::stringstream paths the solvers used before,
+// against the tokenizer with its scalar fallback and with the vectorised matchers of this build.
+namespace tokenizer
+{
+
+    struct tokenizer_options
+    {
+        size_t size = 64 * 1024 * 1024; // Bytes of generated text.
+        size_t iterations = 5;
+        std::string input_filename;
+    };
+
+    struct tokenizer_result
+    {
+        uint64_t checksum = 0;
+        size_t count = 0;
+        std::chrono::nanoseconds median = {};
+    };
+
+    // Random non-negative integers of up to `max_digits` digits, every one followed by `separator`.
+    std::string generate_text(const size_t size, const size_t max_digits, const char separator)
+    {
+        std::mt19937_64 engine(1);
+        std::uniform_int_distribution<size_t> digit_count(1, max_digits);
+        std::uniform_int_distribution<int> digit(0, 9);
+
+        std::string text;
+        text.reserve(size + max_digits + 1);
+        while (text.size() < size)
+        {
+            const auto count = digit_count(engine);
+            text.push_back(static_cast<char>('1' + digit(engine) % 9));
+            for (size_t i = 1; i < count; i++)
+            {
+                text.push_back(static_cast<char>('0' + digit(engine)));
+            }
+            text.push_back(separator);
+        }
+        return text;
+    }
+
+    uint64_t sum_values(const std::vector<int64_t>& values)
+    {
+        uint64_t sum = 0;
+        for (const auto value : values)
+        {
+            sum += static_cast<uint64_t>(value);
+        }
+        return sum;
+    }
+
+    template<typename TFunction>
+    tokenizer_result measure(const tokenizer_options& options, TFunction&& function)
+    {
+        tokenizer_result result;
+        std::vector<std::chrono::nanoseconds> samples;
+        std::vector<int64_t> values;
+
+        for (size_t i = 0; i < options.iterations; i++)
+        {
+            values.clear();
+            const auto start = std::chrono::steady_clock::now();
+            function(values);
+            samples.push_back(std::chrono::steady_clock::now() - start);
+        }
+
+        result.checksum = sum_values(values);
+        result.count = values.size();
+        result.median = aoc::calculate_timing_statistics(std::move(samples)).median;
+        return result;
+    }
+
+    void print_result(const std::string_view name, const size_t bytes, const tokenizer_result& result, const tokenizer_result& baseline)
+    {
+        const auto seconds = std::chrono::duration<double>(result.median).count();
+        const auto gigabytes_per_second = seconds > 0.0 ? static_cast<double>(bytes) / seconds / 1e9 : 0.0;
+        const auto speedup = result.median.count() > 0 ? static_cast<double>(baseline.median.count()) / static_cast<double>(result.median.count()) : 0.0;
+
+        std::cout << "  " << std::left << std::setw(24) << name << std::right <<
+            std::setw(10) << std::fixed << std::setprecision(3) << std::chrono::duration<double, std::milli>(result.median).count() << " ms" <<
+            std::setw(9) << std::setprecision(3) << gigabytes_per_second << " GB/s" <<
+            std::setw(8) << std::setprecision(1) << speedup << "x" <<
+            "    values: " << result.count << ", checksum: " << result.checksum <<
+            (result.checksum == baseline.checksum && result.count == baseline.count ? "" : "  MISMATCH") << "\n";
+    }
+
+    // One integer per line, as read_input<int64_t> reads the input of day 1.
+    void benchmark_lines(const tokenizer_options& options, const std::string_view text)
+    {
+        std::cout << "Lines, " << text.size() << " bytes:\n";
+
+        const auto getline = measure(options, [text](std::vector<int64_t>& values)
+        {
+            std::istringstream stream{ std::string(text) };
+            std::string line;
+            while (std::getline(stream, line))
+            {
+                int64_t value = 0;
+                if (std::from_chars(line.data(), line.data() + line.size(), value).ec == std::errc())
+                {
+                    values.push_back(value);
+                }
+            }
+        });
+        print_result("getline + from_chars", text.size(), getline, getline);
+
+        const auto find = measure(options, [text](std::vector<int64_t>& values)
+        {
+            size_t begin = 0;
+            while (begin < text.size())
+            {
+                auto end = text.find('\n', begin);
+                end = end == std::string_view::npos ? text.size() : end;
+                int64_t value = 0;
+                if (std::from_chars(text.data() + begin, text.data() + end, value).ec == std::errc())
+                {
+                    values.push_back(value);
+                }
+                begin = end + 1;
+            }
+        });
+        print_result("find + from_chars", text.size(), find, getline);
+
+        print_result("lines + parse_integer", text.size(), measure(options, [text](std::vector<int64_t>& values)
+        {
+            aoc::for_each_line(text, [&values](const std::string_view line)
+            {
+                int64_t value = 0;
+                if (aoc::parse_integer(line, value))
+                {
+                    values.push_back(value);
+                }
+            });
+        }), getline);
+
+        print_result("parse_integers scalar", text.size(), measure(options, [text](std::vector<int64_t>& values)
+        {
+            aoc::detail::parse_integers<false>(text, values);
+        }), getline);
+
+        print_result("parse_integers " + std::string(aoc::get_tokenizer_instruction_set()), text.size(), measure(options, [text](std::vector<int64_t>& values)
+        {
+            aoc::parse_integers(text, values);
+        }), getline);
+    }
+
+    // Comma separated integers on one line, as days 6 and 7 read them.
+    void benchmark_separated(const tokenizer_options& options, const std::string_view text)
+    {
+        std::cout << "Comma separated, " << text.size() << " bytes:\n";
+
+        const auto stringstream = measure(options, [text](std::vector<int64_t>& values)
+        {
+            std::stringstream stream{ std::string(text) };
+            int64_t value = 0;
+            char separator = 0;
+            while (stream >> value)
+            {
+                values.push_back(value);
+                stream >> separator;
+            }
+        });
+        print_result("stringstream", text.size(), stringstream, stringstream);
+
+        print_result("parse_integers scalar", text.size(), measure(options, [text](std::vector<int64_t>& values)
+        {
+            aoc::detail::parse_integers<false>(text, values);
+        }), stringstream);
+
+        print_result("parse_integers " + std::string(aoc::get_tokenizer_instruction_set()), text.size(), measure(options, [text](std::vector<int64_t>& values)
+        {
+            aoc::parse_integers(text, values);
+        }), stringstream);
+    }
+
+    void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " [options]\n"
+            "  --size <MiB>         Size of the generated texts. Default: 64.\n"
+            "  --iterations <count> Timed iterations per benchmark. Default: 5.\n"
+            "  --input <file>       Parse the lines of this file instead of generated ones.\n"
+            "  --help               Print this message.\n";
+    }
+
+    tokenizer_options parse_tokenizer_options(int argc, char** argv)
+    {
+        tokenizer_options result;
+
+        auto fail = [&](const std::string& message)
+        {
+            std::cerr << "parse_tokenizer_options: " << message << "\n";
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        };
+
+        auto next_value = [&](int& index) -> std::string_view
+        {
+            if (index + 1 >= argc)
+            {
+                fail(std::string("Missing value for ") + argv[index]);
+            }
+            return argv[++index];
+        };
+
+        auto next_count = [&](int& index) -> size_t
+        {
+            const auto text = next_value(index);
+            size_t value = 0;
+            auto parse_result = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (parse_result.ec != std::errc() || parse_result.ptr != text.data() + text.size())
+            {
+                fail("Invalid value: " + std::string(text));
+            }
+            return value;
+        };
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--size")
+            {
+                result.size = next_count(i) * 1024 * 1024;
+            }
+            else if (argument == "--iterations")
+            {
+                result.iterations = next_count(i);
+            }
+            else if (argument == "--input")
+            {
+                result.input_filename = next_value(i);
+            }
+            else if (argument == "--help")
+            {
+                print_usage(argv[0]);
+                std::exit(EXIT_SUCCESS);
+            }
+            else
+            {
+                fail("Unknown argument: " + std::string(argument));
+            }
+        }
+
+        if (result.size == 0 || result.iterations == 0)
+        {
+            fail("Size and iterations must be at least 1.");
+        }
+
+        return result;
+    }
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto options = tokenizer::parse_tokenizer_options(argc, argv);
+    std::cout << "Tokenizer instruction set: " << aoc::get_tokenizer_instruction_set() << ", median of " << options.iterations << " iterations.\n";
+
+    if (!options.input_filename.empty())
+    {
+        aoc::mapped_file file;
+        if (!file.open(options.input_filename))
+        {
+            std::cerr << "Failed to open file: " << options.input_filename << "\n";
+            return EXIT_FAILURE;
+        }
+        tokenizer::benchmark_lines(options, file.view());
+        return EXIT_SUCCESS;
+    }
+
+    tokenizer::benchmark_lines(options, tokenizer::generate_text(options.size, 5, '\n'));
+    tokenizer::benchmark_separated(options, tokenizer::generate_text(options.size, 4, ','));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+#ifndef AOC_UTILITY_ALLOCATION_HOOKS_HPP
+#define AOC_UTILITY_ALLOCATION_HOOKS_HPP
+
+// Replaces the global operator new and delete to feed the allocation counters.
+// Must be included by exactly one translation unit per executable, which is main.cpp.
+
+#if defined(AOC_TRACK_ALLOCATIONS)
+
+#include "allocations.hpp"
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+namespace aoc::allocation_hooks
+{
+
+    // Stored right in front of every returned pointer.
+    struct allocation_header
+    {
+        void* block;
+        size_t size;
+    };
+
+    inline void* allocate(const size_t size, size_t alignment) noexcept
+    {
+        alignment = std::max(alignment, alignof(std::max_align_t));
+        alignment = std::max(alignment, sizeof(allocation_header));
+
+        void* block = std::malloc(size + alignment + sizeof(allocation_header));
+        if (block == nullptr)
+        {
+            return nullptr;
+        }
+
+        const auto address = (reinterpret_cast<uintptr_t>(block) + sizeof(allocation_header) + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+        auto* header = reinterpret_cast<allocation_header*>(address) - 1;
+        header->block = block;
+        header->size = size;
+
+        record_allocation(size);
+        return reinterpret_cast<void*>(address);
+    }
+
+    inline void* allocate_or_throw(const size_t size, const size_t alignment)
+    {
+        void* pointer = allocate(size, alignment);
+        if (pointer == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+
+    inline void deallocate(void* pointer) noexcept
+    {
+        if (pointer == nullptr)
+        {
+            return;
+        }
+
+        const auto* header = static_cast<allocation_header*>(pointer) - 1;
+        record_deallocation(header->size);
+        std::free(header->block);
+    }
+
+}
+
+void* operator new(size_t size) { return aoc::allocation_hooks::allocate_or_throw(size, 0); }
+void* operator new[](size_t size) { return aoc::allocation_hooks::allocate_or_throw(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return aoc::allocation_hooks::allocate_or_throw(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return aoc::allocation_hooks::allocate_or_throw(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return aoc::allocation_hooks::allocate(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return aoc::allocation_hooks::allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return aoc::allocation_hooks::allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return aoc::allocation_hooks::allocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete(void* pointer, size_t) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { aoc::allocation_hooks::deallocate(pointer); }
+
+#endif
+
+#endif
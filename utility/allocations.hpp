@@ -0,0 +1,173 @@
+#ifndef AOC_UTILITY_ALLOCATIONS_HPP
+#define AOC_UTILITY_ALLOCATIONS_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <algorithm>
+#include <utility>
+#include <ostream>
+
+namespace aoc
+{
+
+    struct allocation_statistics
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+        uint64_t peak_bytes = 0; // Highest number of live bytes above the level at the start of the measurement, on the measuring thread.
+    };
+
+    // Allocations of task scheduler tasks, added up for the part that spawned them, on whichever threads they ran.
+    struct task_allocation_counters
+    {
+        std::atomic<uint64_t> count = 0;
+        std::atomic<uint64_t> bytes = 0;
+    };
+
+    // Counters of the calling thread, maintained by the operator new/delete replacements in allocation_hooks.hpp.
+    struct allocation_counters
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+        int64_t live_bytes = 0;
+        int64_t peak_live_bytes = 0;
+        task_allocation_counters* task = nullptr; // Counts allocations instead of count and bytes while the thread runs a task.
+        task_allocation_counters* spawned_tasks = nullptr; // Handed to the tasks the thread spawns.
+    };
+
+    inline allocation_counters& get_allocation_counters()
+    {
+        thread_local allocation_counters counters;
+        return counters;
+    }
+
+    inline void record_allocation(const size_t size)
+    {
+        auto& counters = get_allocation_counters();
+        if (counters.task != nullptr)
+        {
+            counters.task->count.fetch_add(1, std::memory_order_relaxed);
+            counters.task->bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+        else
+        {
+            ++counters.count;
+            counters.bytes += size;
+        }
+        counters.live_bytes += static_cast<int64_t>(size);
+        counters.peak_live_bytes = std::max(counters.peak_live_bytes, counters.live_bytes);
+    }
+
+    inline void record_deallocation(const size_t size)
+    {
+        get_allocation_counters().live_bytes -= static_cast<int64_t>(size);
+    }
+
+    inline constexpr bool is_tracking_allocations()
+    {
+#if defined(AOC_TRACK_ALLOCATIONS)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Runs a task with the counters of the part that spawned it, also for the tasks it spawns in turn.
+    class task_allocation_scope
+    {
+
+    public:
+
+        explicit task_allocation_scope(task_allocation_counters* task) :
+            m_previous_task(get_allocation_counters().task),
+            m_previous_spawned_tasks(get_allocation_counters().spawned_tasks)
+        {
+            auto& counters = get_allocation_counters();
+            counters.task = task;
+            counters.spawned_tasks = task;
+        }
+
+        ~task_allocation_scope()
+        {
+            auto& counters = get_allocation_counters();
+            counters.task = m_previous_task;
+            counters.spawned_tasks = m_previous_spawned_tasks;
+        }
+
+        task_allocation_scope(const task_allocation_scope&) = delete;
+        task_allocation_scope& operator = (const task_allocation_scope&) = delete;
+
+    private:
+
+        task_allocation_counters* m_previous_task;
+        task_allocation_counters* m_previous_spawned_tasks;
+
+    };
+
+    // Measures the allocations of the calling thread between start() and stop(), and those of the scheduler tasks it spawns
+    // in between on any thread. Accumulates over several measurements. The peak only covers the calling thread.
+    class allocation_tracker
+    {
+
+    public:
+
+        allocation_tracker() = default;
+        allocation_tracker(const allocation_tracker&) = delete;
+        allocation_tracker& operator = (const allocation_tracker&) = delete;
+
+        void start()
+        {
+            auto& counters = get_allocation_counters();
+            m_start = { counters.count, counters.bytes, counters.live_bytes };
+            counters.peak_live_bytes = counters.live_bytes;
+            m_previous_spawned_tasks = std::exchange(counters.spawned_tasks, &m_tasks);
+        }
+
+        // Every task spawned since start() has finished, parts sync their task groups before returning.
+        void stop()
+        {
+            auto& counters = get_allocation_counters();
+            counters.spawned_tasks = m_previous_spawned_tasks;
+            m_statistics.count += counters.count - m_start.count + m_tasks.count.exchange(0, std::memory_order_relaxed);
+            m_statistics.bytes += counters.bytes - m_start.bytes + m_tasks.bytes.exchange(0, std::memory_order_relaxed);
+            m_statistics.peak_bytes = std::max(m_statistics.peak_bytes, static_cast<uint64_t>(std::max(int64_t{ 0 }, counters.peak_live_bytes - m_start.live_bytes)));
+        }
+
+        const allocation_statistics& get_statistics() const
+        {
+            return m_statistics;
+        }
+
+    private:
+
+        struct thread_counts
+        {
+            uint64_t count = 0;
+            uint64_t bytes = 0;
+            int64_t live_bytes = 0;
+        };
+
+        thread_counts m_start;
+        task_allocation_counters m_tasks;
+        task_allocation_counters* m_previous_spawned_tasks = nullptr;
+        allocation_statistics m_statistics;
+
+    };
+
+    inline allocation_statistics divide_allocation_statistics(const allocation_statistics& statistics, const uint64_t divisor)
+    {
+        const auto safe_divisor = divisor == 0 ? 1 : divisor;
+        return { statistics.count / safe_divisor, statistics.bytes / safe_divisor, statistics.peak_bytes };
+    }
+
+    inline void print_allocation_statistics(std::ostream& output, const allocation_statistics& statistics)
+    {
+        output << "    allocations: " << statistics.count <<
+            ", allocated: " << statistics.bytes << " bytes" <<
+            ", peak: " << statistics.peak_bytes << " bytes\n";
+    }
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef AOC_UTILITY_ARENA_HPP
+#define AOC_UTILITY_ARENA_HPP
+
+#include <memory_resource>
+#include <memory>
+#include <optional>
+#include <cstddef>
+
+// Per-part arena for short-lived allocations of solvers. solve_puzzle installs a part_arena on the thread running a part,
+// solvers allocate their pmr containers from get_part_memory_resource(), and the whole arena is freed at once after every run.
+namespace aoc
+{
+
+    inline constexpr size_t part_arena_initial_size = 64 * 1024;
+
+    namespace detail
+    {
+
+        inline std::pmr::memory_resource*& get_current_memory_resource()
+        {
+            thread_local std::pmr::memory_resource* resource = nullptr;
+            return resource;
+        }
+
+    }
+
+    // Arena of the part running on the calling thread, or the default resource outside of a part.
+    inline std::pmr::memory_resource* get_part_memory_resource()
+    {
+        auto* resource = detail::get_current_memory_resource();
+        return resource != nullptr ? resource : std::pmr::get_default_resource();
+    }
+
+    // Makes `resource` the part memory resource of the calling thread until the end of the scope. nullptr selects the default resource.
+    class memory_resource_scope
+    {
+
+    public:
+
+        explicit memory_resource_scope(std::pmr::memory_resource* resource) :
+            m_previous(detail::get_current_memory_resource())
+        {
+            detail::get_current_memory_resource() = resource;
+        }
+
+        ~memory_resource_scope()
+        {
+            detail::get_current_memory_resource() = m_previous;
+        }
+
+        memory_resource_scope(const memory_resource_scope&) = delete;
+        memory_resource_scope& operator = (const memory_resource_scope&) = delete;
+
+    private:
+
+        std::pmr::memory_resource* m_previous;
+
+    };
+
+    // Monotonic arena that is reset between runs of a part. Allocations past the buffer go to the heap;
+    // reset() then grows the buffer by that amount, so repeated runs of the same part stop allocating.
+    class part_arena
+    {
+
+    public:
+
+        explicit part_arena(const size_t initial_size = part_arena_initial_size) :
+            m_buffer(new std::byte[initial_size]),
+            m_buffer_size(initial_size)
+        {
+            m_resource.emplace(m_buffer.get(), m_buffer_size, &m_upstream);
+        }
+
+        part_arena(const part_arena&) = delete;
+        part_arena& operator = (const part_arena&) = delete;
+
+        std::pmr::memory_resource* get_resource()
+        {
+            return &*m_resource;
+        }
+
+        size_t get_buffer_size() const
+        {
+            return m_buffer_size;
+        }
+
+        // Frees everything allocated from the arena.
+        void reset()
+        {
+            const auto overflow_bytes = m_upstream.get_allocated_bytes();
+            m_resource.reset();
+            m_upstream.clear();
+
+            if (overflow_bytes != 0)
+            {
+                m_buffer_size += overflow_bytes;
+                m_buffer.reset(new std::byte[m_buffer_size]);
+            }
+            m_resource.emplace(m_buffer.get(), m_buffer_size, &m_upstream);
+        }
+
+    private:
+
+        // Heap resource that counts the bytes handed to the arena since the last reset.
+        class counting_resource : public std::pmr::memory_resource
+        {
+
+        public:
+
+            size_t get_allocated_bytes() const
+            {
+                return m_allocated_bytes;
+            }
+
+            void clear()
+            {
+                m_allocated_bytes = 0;
+            }
+
+        private:
+
+            void* do_allocate(const size_t bytes, const size_t alignment) override
+            {
+                m_allocated_bytes += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* pointer, const size_t bytes, const size_t alignment) override
+            {
+                std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+            }
+
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+
+            size_t m_allocated_bytes = 0;
+
+        };
+
+        counting_resource m_upstream;
+        std::unique_ptr<std::byte[]> m_buffer;
+        size_t m_buffer_size;
+        std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+
+    };
+
+}
+
+#endif
@@ -4,40 +4,177 @@
 #include <memory>
 #include <iostream>
 #include <functional>
+#include <span>
+#include <new>
+#include <array>
+#include <algorithm>
+#include <utility>
 #include "vector.hpp"
+#include "array2_layout.hpp"
 
 namespace aoc
 {
 
+    // Alignment of the first element of every Array2, so rows start on a cache line when their width allows it.
+    inline constexpr size_t array2_alignment = 64;
+
+    // Destroys the elements and releases the aligned block allocated by make_array2.
+    template<typename T>
+    struct Array2Deleter
+    {
+        size_t count = 0;
+
+        void operator () (T* pointer) const
+        {
+            std::destroy_n(pointer, count);
+            ::operator delete(pointer, std::align_val_t{ array2_alignment });
+        }
+    };
+
+    // Non-owning view into rows of an Array2, or any block of them, whose rows are `stride` elements apart.
     template<typename T>
+    struct Array2View
+    {
+        using Type = T;
+
+        T* data = nullptr;
+        Vector2s size = {};
+        size_t stride = 0;
+
+        T& operator () (const size_t x, const size_t y) const
+        {
+            return data[y * stride + x];
+        }
+
+        std::span<T> row(const size_t y) const
+        {
+            return { data + y * stride, size.x };
+        }
+
+        Array2View subview(const Vector2s position, const Vector2s sub_size) const
+        {
+            return { data + position.y * stride + position.x, sub_size, stride };
+        }
+
+        bool is_outside(const Vector2i32 position) const
+        {
+            return position.x < 0 || position.y < 0 || position.x >= size.x || position.y >= size.y;
+        }
+    };
+
+    // 2D array in a single contiguous, cache line aligned allocation. TLayout maps (x, y) to the storage, see array2_layout.hpp.
+    // Rows, spans and views are only available for the row-major layout.
+    template<typename T, typename TLayout = RowMajorLayout>
     struct Array2
     {
         using Type = T;
-        using DataRow = std::unique_ptr<T[]>;
-        using Data = std::unique_ptr<DataRow[]>;
+        using Layout = TLayout;
+        using Data = std::unique_ptr<T[], Array2Deleter<T>>;
 
     	Vector2s size = {};
+        TLayout layout = {};
         Data data = nullptr;
 
         Array2() = default;
 
         Array2(const Vector2s size, Data&& data) :
             size(size),
+            layout(size),
             data(std::move(data))
         {}
 
+        Array2(const Array2& rhs);
+
+        // A moved-from array is empty, like a default constructed one.
         Array2(Array2&& rhs) noexcept :
-            size(rhs.size),
+            size(std::exchange(rhs.size, {})),
+            layout(std::exchange(rhs.layout, {})),
             data(std::move(rhs.data))
         { }
 
-        Array2& operator = (Array2&& rhs)
+        Array2& operator = (const Array2& rhs)
+        {
+            return *this = Array2(rhs);
+        }
+
+        Array2& operator = (Array2&& rhs) noexcept
         {
-            size = rhs.size;
+            size = std::exchange(rhs.size, {});
+            layout = std::exchange(rhs.layout, {});
             data = std::move(rhs.data);
             return *this;
         }
 
+        T& operator () (const size_t x, const size_t y)
+        {
+            return data[layout.get_index(x, y)];
+        }
+
+        const T& operator () (const size_t x, const size_t y) const
+        {
+            return data[layout.get_index(x, y)];
+        }
+
+        T& operator [] (const Vector2s position)
+        {
+            return data[layout.get_index(position.x, position.y)];
+        }
+
+        const T& operator [] (const Vector2s position) const
+        {
+            return data[layout.get_index(position.x, position.y)];
+        }
+
+        size_t get_capacity() const
+        {
+            return layout.get_capacity();
+        }
+
+        size_t get_stride() const requires TLayout::is_row_major
+        {
+            return size.x;
+        }
+
+        std::span<T> row(const size_t y) requires TLayout::is_row_major
+        {
+            return { data.get() + y * size.x, size.x };
+        }
+
+        std::span<const T> row(const size_t y) const requires TLayout::is_row_major
+        {
+            return { data.get() + y * size.x, size.x };
+        }
+
+        std::span<T> span() requires TLayout::is_row_major
+        {
+            return { data.get(), size.x * size.y };
+        }
+
+        std::span<const T> span() const requires TLayout::is_row_major
+        {
+            return { data.get(), size.x * size.y };
+        }
+
+        Array2View<T> view() requires TLayout::is_row_major
+        {
+            return { data.get(), size, size.x };
+        }
+
+        Array2View<const T> view() const requires TLayout::is_row_major
+        {
+            return { data.get(), size, size.x };
+        }
+
+        Array2View<T> subview(const Vector2s position, const Vector2s sub_size) requires TLayout::is_row_major
+        {
+            return view().subview(position, sub_size);
+        }
+
+        Array2View<const T> subview(const Vector2s position, const Vector2s sub_size) const requires TLayout::is_row_major
+        {
+            return view().subview(position, sub_size);
+        }
+
         bool is_outside(const Vector2i32 position) const
         {
             return position.x < 0 || position.y < 0 || position.x >= size.x || position.y >= size.y;
@@ -45,38 +182,84 @@ namespace aoc
         
     };
 
-    template<typename T>
-    Array2<T> make_array2(Vector2s size)
+    // Allocates an aligned block for `count` elements and calls construct(pointer) to build all of them.
+    // The deleter only takes ownership of the elements once construct returned. If it throws, the std::uninitialized_*
+    // algorithms have already destroyed what they built, and only the block is released.
+    template<typename T, typename TConstruct>
+    typename Array2<T>::Data allocate_array2_data(const size_t count, TConstruct&& construct)
+    {
+        auto* pointer = static_cast<T*>(::operator new(std::max(count, size_t{ 1 }) * sizeof(T), std::align_val_t{ array2_alignment }));
+        try
+        {
+            construct(pointer);
+        }
+        catch (...)
+        {
+            ::operator delete(pointer, std::align_val_t{ array2_alignment });
+            throw;
+        }
+        return typename Array2<T>::Data{ pointer, Array2Deleter<T>{ count } };
+    }
+
+    template<typename T, typename TLayout>
+    Array2<T, TLayout>::Array2(const Array2& rhs) :
+        size(rhs.size),
+        layout(rhs.layout),
+        data(allocate_array2_data<T>(rhs.get_capacity(), [&rhs](T* pointer)
+        {
+            std::uninitialized_copy_n(rhs.data.get(), rhs.get_capacity(), pointer);
+        }))
+    {
+    }
+
+    // Value initialises every element, including the padding of the layout, which zeroes trivial types.
+    template<typename T, typename TLayout = RowMajorLayout>
+    Array2<T, TLayout> make_array2(Vector2s size)
     {
-        Array2<T> array2d{ size, std::make_unique<typename Array2<T>::DataRow[]>(size.y) };
-        for (size_t i = 0; i < size.y; i++)
+        const auto capacity = TLayout(size).get_capacity();
+        auto data = allocate_array2_data<T>(capacity, [capacity](T* pointer)
         {
-            array2d.data[i] = std::make_unique<T[]>(size.x);
+            std::uninitialized_value_construct_n(pointer, capacity);
+        });
+        return Array2<T, TLayout>{ size, std::move(data) };
+    }
+
+    // Calls callback(position, element) for every neighbour at the given offsets that is inside the array, in any layout.
+    template<typename T, typename TLayout, size_t VCount, typename TCallback>
+    void for_each_neighbour(Array2<T, TLayout>& array2, const Vector2s position, const std::array<Vector2i32, VCount>& offsets, TCallback&& callback)
+    {
+        for (const auto offset : offsets)
+        {
+            const auto neighbour = Vector2i32{ static_cast<int32_t>(position.x) + offset.x, static_cast<int32_t>(position.y) + offset.y };
+            if (!array2.is_outside(neighbour))
+            {
+                const auto neighbour_position = Vector2s{ static_cast<size_t>(neighbour.x), static_cast<size_t>(neighbour.y) };
+                callback(neighbour_position, array2[neighbour_position]);
+            }
         }
-        return array2d;
     }
 
-    template<typename TPrint, typename T>
-    void print_array2(const Array2<T>& array2)
+    template<typename TPrint, typename T, typename TLayout>
+    void print_array2(const Array2<T, TLayout>& array2)
     {
         for (size_t y = 0; y < array2.size.y; y++)
         {
             for (size_t x = 0; x < array2.size.x; x++)
             {
-                std::cout << static_cast<TPrint>(array2.data[y][x]);
+                std::cout << static_cast<TPrint>(array2(x, y));
             }
             std::cout << "\n";
         }
     }
 
-    template<typename TPrint, typename T, typename TReturn>
-    void print_array2_2(const Array2<T>& array2, const std::function<TReturn(const T&)> & print_func)
+    template<typename TPrint, typename T, typename TLayout, typename TReturn>
+    void print_array2_2(const Array2<T, TLayout>& array2, const std::function<TReturn(const T&)> & print_func)
     {
         for (size_t y = 0; y < array2.size.y; y++)
         {
             for (size_t x = 0; x < array2.size.x; x++)
             {
-                std::cout << static_cast<TPrint>(print_func(array2.data[y][x]));
+                std::cout << static_cast<TPrint>(print_func(array2(x, y)));
             }
             std::cout << "\n";
         }
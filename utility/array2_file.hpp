@@ -0,0 +1,306 @@
+#ifndef AOC_UTILITY_ARRAY2_FILE_HPP
+#define AOC_UTILITY_ARRAY2_FILE_HPP
+
+#include "halo_array2.hpp"
+#include "mapped_file.hpp"
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+#include <limits>
+
+// Binary file format of Array2 grids: a fixed header followed by the raw storage of the array, as laid out in memory.
+// The data starts at a multiple of array2_alignment, so a memory mapped file can be read in place through an Array2View.
+namespace aoc
+{
+
+    enum class array2_element_type : uint32_t
+    {
+        unknown = 0,
+        uint8 = 1,
+        int8 = 2,
+        uint16 = 3,
+        int16 = 4,
+        uint32 = 5,
+        int32 = 6,
+        uint64 = 7,
+        int64 = 8,
+        float32 = 9,
+        float64 = 10
+    };
+
+    enum class array2_file_layout : uint32_t
+    {
+        row_major = 1,
+        tiled = 2,
+        morton = 3
+    };
+
+    inline constexpr char array2_file_magic[8] = { 'A', 'O', 'C', 'A', 'R', 'R', '2', '\0' };
+    inline constexpr uint32_t array2_file_version = 1;
+
+    struct array2_file_header
+    {
+        char magic[8] = {};
+        uint32_t version = 0;
+        array2_element_type element_type = array2_element_type::unknown;
+        uint32_t element_size = 0;
+        array2_file_layout layout = array2_file_layout::row_major;
+        uint32_t tile_size = 0; // Only used by the tiled layout.
+        uint32_t halo = 0; // Width of the border around the interior, included in the storage.
+        uint64_t width = 0; // Interior size.
+        uint64_t height = 0;
+        uint64_t storage_width = 0; // Size including the halo.
+        uint64_t storage_height = 0;
+        uint64_t element_count = 0; // Capacity of the layout, number of stored elements.
+        uint64_t data_offset = 0; // Bytes from the start of the file.
+    };
+
+    namespace detail
+    {
+
+        // a * b, or false if it does not fit into 64 bits.
+        inline bool checked_multiply(const uint64_t a, const uint64_t b, uint64_t& result)
+        {
+            if (a != 0 && b > std::numeric_limits<uint64_t>::max() / a)
+            {
+                return false;
+            }
+            result = a * b;
+            return true;
+        }
+
+        // a + b, or false if it does not fit into 64 bits.
+        inline bool checked_add(const uint64_t a, const uint64_t b, uint64_t& result)
+        {
+            if (b > std::numeric_limits<uint64_t>::max() - a)
+            {
+                return false;
+            }
+            result = a + b;
+            return true;
+        }
+
+    }
+
+    template<typename T>
+    constexpr array2_element_type get_array2_element_type()
+    {
+        using type = std::remove_cv_t<T>;
+        if constexpr (std::is_same_v<type, uint8_t>) { return array2_element_type::uint8; }
+        else if constexpr (std::is_same_v<type, int8_t>) { return array2_element_type::int8; }
+        else if constexpr (std::is_same_v<type, uint16_t>) { return array2_element_type::uint16; }
+        else if constexpr (std::is_same_v<type, int16_t>) { return array2_element_type::int16; }
+        else if constexpr (std::is_same_v<type, uint32_t>) { return array2_element_type::uint32; }
+        else if constexpr (std::is_same_v<type, int32_t>) { return array2_element_type::int32; }
+        else if constexpr (std::is_same_v<type, uint64_t>) { return array2_element_type::uint64; }
+        else if constexpr (std::is_same_v<type, int64_t>) { return array2_element_type::int64; }
+        else if constexpr (std::is_same_v<type, float>) { return array2_element_type::float32; }
+        else if constexpr (std::is_same_v<type, double>) { return array2_element_type::float64; }
+        else { return array2_element_type::unknown; }
+    }
+
+    template<typename TLayout>
+    constexpr array2_file_layout get_array2_file_layout()
+    {
+        if constexpr (TLayout::is_row_major) { return array2_file_layout::row_major; }
+        else if constexpr (std::is_same_v<TLayout, MortonLayout>) { return array2_file_layout::morton; }
+        else { return array2_file_layout::tiled; }
+    }
+
+    template<typename TLayout>
+    constexpr uint32_t get_array2_file_tile_size()
+    {
+        if constexpr (requires { TLayout::tile_size; })
+        {
+            return static_cast<uint32_t>(TLayout::tile_size);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    // Writes the whole storage of an array, halo included. Returns false on failure.
+    template<typename T, typename TLayout>
+    bool write_array2_file(const std::string& filename, const Array2<T, TLayout>& storage, const size_t halo = 0)
+    {
+        static_assert(get_array2_element_type<T>() != array2_element_type::unknown, "Element type has no binary representation.");
+
+        array2_file_header header;
+        std::memcpy(header.magic, array2_file_magic, sizeof(header.magic));
+        header.version = array2_file_version;
+        header.element_type = get_array2_element_type<T>();
+        header.element_size = sizeof(T);
+        header.layout = get_array2_file_layout<TLayout>();
+        header.tile_size = get_array2_file_tile_size<TLayout>();
+        header.halo = static_cast<uint32_t>(halo);
+        header.width = storage.size.x - 2 * halo;
+        header.height = storage.size.y - 2 * halo;
+        header.storage_width = storage.size.x;
+        header.storage_height = storage.size.y;
+        header.element_count = storage.get_capacity();
+        header.data_offset = (sizeof(array2_file_header) + array2_alignment - 1) / array2_alignment * array2_alignment;
+
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "write_array2_file: Failed to open file: " << filename << "\n";
+            return false;
+        }
+
+        const char padding[array2_alignment] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(padding, static_cast<std::streamsize>(header.data_offset - sizeof(header)));
+        file.write(reinterpret_cast<const char*>(storage.data.get()), static_cast<std::streamsize>(header.element_count * sizeof(T)));
+        return file.good();
+    }
+
+    template<typename T, typename TLayout>
+    bool write_array2_file(const std::string& filename, const HaloArray2<T, TLayout>& array2)
+    {
+        return write_array2_file(filename, array2.storage, array2.halo);
+    }
+
+    // Memory mapped Array2 file of element type T. The views are valid for the lifetime of the mapping.
+    template<typename T>
+    class mapped_array2
+    {
+
+    public:
+
+        // Maps and validates the file. Prints the reason and returns false if it is not a grid of T.
+        bool open(const std::string& filename)
+        {
+            m_data = nullptr;
+            if (!m_file.open(filename))
+            {
+                std::cerr << "mapped_array2: Failed to map file: " << filename << "\n";
+                return false;
+            }
+
+            const auto bytes = m_file.view();
+            if (bytes.size() < sizeof(array2_file_header))
+            {
+                return fail(filename, "File is too small.");
+            }
+
+            std::memcpy(&m_header, bytes.data(), sizeof(m_header));
+            if (std::memcmp(m_header.magic, array2_file_magic, sizeof(m_header.magic)) != 0)
+            {
+                return fail(filename, "Not an Array2 file.");
+            }
+            if (m_header.version != array2_file_version)
+            {
+                return fail(filename, "Unsupported version " + std::to_string(m_header.version) + ".");
+            }
+            if (m_header.element_type != get_array2_element_type<T>() || m_header.element_size != sizeof(T))
+            {
+                return fail(filename, "Unexpected element type.");
+            }
+            // Every size comes from the file, so sums and products are checked before the views index the mapping with them.
+            const auto halo_size = 2 * static_cast<uint64_t>(m_header.halo);
+            if (m_header.width > m_header.storage_width || m_header.storage_width - m_header.width < halo_size ||
+                m_header.height > m_header.storage_height || m_header.storage_height - m_header.height < halo_size)
+            {
+                return fail(filename, "Size and halo do not fit into the storage.");
+            }
+
+            uint64_t storage_count = 0;
+            uint64_t data_size = 0;
+            uint64_t data_end = 0;
+            if (!detail::checked_multiply(m_header.storage_width, m_header.storage_height, storage_count) ||
+                !detail::checked_multiply(m_header.element_count, sizeof(T), data_size) ||
+                !detail::checked_add(m_header.data_offset, data_size, data_end))
+            {
+                return fail(filename, "Size overflows.");
+            }
+            if (m_header.data_offset < sizeof(array2_file_header) || m_header.data_offset % alignof(T) != 0 || data_end > bytes.size())
+            {
+                return fail(filename, "Data is truncated or misaligned.");
+            }
+            if (m_header.element_count < storage_count ||
+                (m_header.layout == array2_file_layout::row_major && m_header.element_count != storage_count))
+            {
+                return fail(filename, "Size does not match the number of elements.");
+            }
+
+            m_data = reinterpret_cast<const T*>(bytes.data() + m_header.data_offset);
+            return true;
+        }
+
+        const array2_file_header& get_header() const
+        {
+            return m_header;
+        }
+
+        bool is_row_major() const
+        {
+            return m_header.layout == array2_file_layout::row_major;
+        }
+
+        // Raw stored elements, in the layout of the file.
+        std::span<const T> get_elements() const
+        {
+            return { m_data, static_cast<size_t>(m_header.element_count) };
+        }
+
+        // Storage including the halo. Row-major files only.
+        Array2View<const T> storage_view() const
+        {
+            const auto size = Vector2s{ static_cast<size_t>(m_header.storage_width), static_cast<size_t>(m_header.storage_height) };
+            return { m_data, size, size.x };
+        }
+
+        // Interior without the halo. Row-major files only.
+        Array2View<const T> view() const
+        {
+            const auto halo = static_cast<size_t>(m_header.halo);
+            return storage_view().subview({ halo, halo }, Vector2s{ static_cast<size_t>(m_header.width), static_cast<size_t>(m_header.height) });
+        }
+
+    private:
+
+        bool fail(const std::string& filename, const std::string& message)
+        {
+            std::cerr << "mapped_array2: " << message << " " << filename << "\n";
+            m_file.close();
+            return false;
+        }
+
+        mapped_file m_file;
+        array2_file_header m_header;
+        const T* m_data = nullptr;
+
+    };
+
+    // Copies an Array2 file into an owned array of the same layout. Returns an empty array on failure.
+    template<typename T, typename TLayout = RowMajorLayout>
+    Array2<T, TLayout> load_array2_file(const std::string& filename)
+    {
+        mapped_array2<T> file;
+        if (!file.open(filename))
+        {
+            return {};
+        }
+
+        // The layout is checked before allocating, open() has already bounded the size by the file size.
+        const auto& header = file.get_header();
+        const auto size = Vector2s{ static_cast<size_t>(header.storage_width), static_cast<size_t>(header.storage_height) };
+        if (header.layout != get_array2_file_layout<TLayout>() || header.tile_size != get_array2_file_tile_size<TLayout>() ||
+            header.element_count != TLayout(size).get_capacity())
+        {
+            std::cerr << "load_array2_file: Layout of the file does not match: " << filename << "\n";
+            return {};
+        }
+
+        auto result = make_array2<T, TLayout>(size);
+        const auto elements = file.get_elements();
+        std::copy(elements.begin(), elements.end(), result.data.get());
+        return result;
+    }
+
+}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef AOC_UTILITY_ARRAY2_LAYOUT_HPP
+#define AOC_UTILITY_ARRAY2_LAYOUT_HPP
+
+#include "vector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// Layout policies of Array2, mapping (x, y) to an offset into its storage.
+// A layout is constructed from the array size and provides get_capacity() and get_index(x, y).
+// Only row-major layouts expose rows, spans and linear neighbour offsets.
+namespace aoc
+{
+
+    struct RowMajorLayout
+    {
+        static constexpr bool is_row_major = true;
+
+        size_t width = 0;
+        size_t height = 0;
+
+        RowMajorLayout() = default;
+
+        explicit RowMajorLayout(const Vector2s size) :
+            width(size.x),
+            height(size.y)
+        {}
+
+        size_t get_capacity() const
+        {
+            return width * height;
+        }
+
+        size_t get_index(const size_t x, const size_t y) const
+        {
+            return y * width + x;
+        }
+    };
+
+    // Square tiles of VTileSize x VTileSize elements, stored one after another in row-major order of the tiles.
+    // Elements within a tile are row-major as well. Edge tiles are padded to full size.
+    template<size_t VTileSize = 64>
+    struct TiledLayout
+    {
+        static_assert(VTileSize > 0 && (VTileSize & (VTileSize - 1)) == 0, "Tile size must be a power of two.");
+
+        static constexpr bool is_row_major = false;
+        static constexpr size_t tile_size = VTileSize;
+        static constexpr size_t tile_mask = VTileSize - 1;
+        static constexpr size_t tile_elements = VTileSize * VTileSize;
+
+        size_t tiles_x = 0;
+        size_t tiles_y = 0;
+
+        TiledLayout() = default;
+
+        explicit TiledLayout(const Vector2s size) :
+            tiles_x((size.x + tile_mask) / tile_size),
+            tiles_y((size.y + tile_mask) / tile_size)
+        {}
+
+        size_t get_capacity() const
+        {
+            return tiles_x * tiles_y * tile_elements;
+        }
+
+        size_t get_index(const size_t x, const size_t y) const
+        {
+            const auto tile = (y / tile_size) * tiles_x + x / tile_size;
+            return tile * tile_elements + (y & tile_mask) * tile_size + (x & tile_mask);
+        }
+    };
+
+    // Z-order curve, interleaving the bits of x and y. Storage covers the smallest power of two square holding the array.
+    struct MortonLayout
+    {
+        static constexpr bool is_row_major = false;
+
+        size_t side = 0;
+
+        MortonLayout() = default;
+
+        explicit MortonLayout(const Vector2s size)
+        {
+            const auto largest = std::max(size.x, size.y);
+            side = largest == 0 ? 0 : 1;
+            while (side < largest)
+            {
+                side <<= 1;
+            }
+        }
+
+        size_t get_capacity() const
+        {
+            return side * side;
+        }
+
+        size_t get_index(const size_t x, const size_t y) const
+        {
+            return spread_bits(static_cast<uint32_t>(x)) | (spread_bits(static_cast<uint32_t>(y)) << 1);
+        }
+
+        // Moves bit i of value to bit 2i.
+        static uint64_t spread_bits(const uint32_t value)
+        {
+            uint64_t result = value;
+            result = (result | (result << 16)) & 0x0000FFFF0000FFFFull;
+            result = (result | (result << 8)) & 0x00FF00FF00FF00FFull;
+            result = (result | (result << 4)) & 0x0F0F0F0F0F0F0F0Full;
+            result = (result | (result << 2)) & 0x3333333333333333ull;
+            result = (result | (result << 1)) & 0x5555555555555555ull;
+            return result;
+        }
+    };
+
+}
+
+#endif
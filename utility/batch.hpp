@@ -0,0 +1,71 @@
+#ifndef AOC_UTILITY_BATCH_HPP
+#define AOC_UTILITY_BATCH_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+
+// Input files of a --batch run, solved by the same day one after another or in parallel.
+namespace aoc
+{
+
+    // Every regular file of a directory, sorted by name, or every file listed in a manifest.
+    // A manifest holds one path per line, relative to the directory of the manifest. Empty lines and lines starting with # are skipped.
+    inline bool list_batch_inputs(const std::string& path, std::vector<std::string>& filenames)
+    {
+        filenames.clear();
+        std::error_code error;
+
+        if (std::filesystem::is_directory(path, error))
+        {
+            for (const auto& entry : std::filesystem::directory_iterator(path, error))
+            {
+                if (entry.is_regular_file(error))
+                {
+                    filenames.push_back(entry.path().string());
+                }
+            }
+            if (error)
+            {
+                std::cerr << "list_batch_inputs: Failed to list directory: " << path << "\n";
+                return false;
+            }
+
+            std::sort(filenames.begin(), filenames.end());
+            return true;
+        }
+
+        std::ifstream manifest(path);
+        if (!manifest.is_open())
+        {
+            std::cerr << "list_batch_inputs: Failed to open file: " << path << "\n";
+            return false;
+        }
+
+        const auto directory = std::filesystem::path(path).parent_path();
+        std::string line;
+        while (std::getline(manifest, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+            if (line.empty() || line.front() == '#')
+            {
+                continue;
+            }
+
+            const std::filesystem::path filename(line);
+            filenames.push_back(filename.is_absolute() ? filename.string() : (directory / filename).string());
+        }
+
+        return true;
+    }
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef AOC_UTILITY_BENCHMARK_HPP
+#define AOC_UTILITY_BENCHMARK_HPP
+
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+namespace aoc
+{
+
+    struct timing_statistics
+    {
+        size_t iterations = 0;
+        std::chrono::nanoseconds min = {};
+        std::chrono::nanoseconds median = {};
+        std::chrono::nanoseconds mean = {};
+        std::chrono::nanoseconds p90 = {};
+        std::chrono::nanoseconds p99 = {};
+        std::chrono::nanoseconds standard_deviation = {};
+    };
+
+    // Nearest-rank percentile of sorted samples.
+    inline std::chrono::nanoseconds get_percentile(const std::vector<std::chrono::nanoseconds>& sorted_samples, const double percentile)
+    {
+        const auto rank = static_cast<size_t>(std::ceil((percentile / 100.0) * static_cast<double>(sorted_samples.size())));
+        return sorted_samples[std::clamp(rank, size_t{ 1 }, sorted_samples.size()) - 1];
+    }
+
+    inline timing_statistics calculate_timing_statistics(std::vector<std::chrono::nanoseconds> samples)
+    {
+        if (samples.empty())
+        {
+            return {};
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        double sum = 0.0;
+        for (const auto sample : samples)
+        {
+            sum += static_cast<double>(sample.count());
+        }
+        const double mean = sum / static_cast<double>(samples.size());
+
+        double squared_sum = 0.0;
+        for (const auto sample : samples)
+        {
+            const double difference = static_cast<double>(sample.count()) - mean;
+            squared_sum += difference * difference;
+        }
+        const double variance = squared_sum / static_cast<double>(samples.size());
+
+        const size_t middle = samples.size() / 2;
+        const auto median = samples.size() % 2 == 0 ?
+            (samples[middle - 1] + samples[middle]) / 2 :
+            samples[middle];
+
+        timing_statistics result;
+        result.iterations = samples.size();
+        result.min = samples.front();
+        result.median = median;
+        result.mean = std::chrono::nanoseconds{ static_cast<int64_t>(mean) };
+        result.p90 = get_percentile(samples, 90.0);
+        result.p99 = get_percentile(samples, 99.0);
+        result.standard_deviation = std::chrono::nanoseconds{ static_cast<int64_t>(std::sqrt(variance)) };
+        return result;
+    }
+
+}
+
+#endif
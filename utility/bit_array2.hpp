@@ -0,0 +1,209 @@
+#ifndef AOC_UTILITY_BIT_ARRAY2_HPP
+#define AOC_UTILITY_BIT_ARRAY2_HPP
+
+#include "array2.hpp"
+#include <bit>
+#include <vector>
+#include <algorithm>
+
+namespace aoc
+{
+
+    inline constexpr size_t bits_per_word = 64;
+
+    inline uint64_t reverse_bits(uint64_t value)
+    {
+        value = ((value >> 1) & 0x5555555555555555ull) | ((value & 0x5555555555555555ull) << 1);
+        value = ((value >> 2) & 0x3333333333333333ull) | ((value & 0x3333333333333333ull) << 2);
+        value = ((value >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((value & 0x0F0F0F0F0F0F0F0Full) << 4);
+        value = ((value >> 8) & 0x00FF00FF00FF00FFull) | ((value & 0x00FF00FF00FF00FFull) << 8);
+        value = ((value >> 16) & 0x0000FFFF0000FFFFull) | ((value & 0x0000FFFF0000FFFFull) << 16);
+        return (value >> 32) | (value << 32);
+    }
+
+    // Mask of the lowest `count` bits, count <= 64.
+    inline uint64_t low_bits_mask(const size_t count)
+    {
+        return count >= bits_per_word ? ~uint64_t{ 0 } : (uint64_t{ 1 } << count) - 1;
+    }
+
+    // 64 bits of `words` starting at bit `position`, zero past the end.
+    inline uint64_t read_word_at(const std::span<const uint64_t> words, const size_t position)
+    {
+        const auto index = position / bits_per_word;
+        const auto shift = position % bits_per_word;
+        if (index >= words.size())
+        {
+            return 0;
+        }
+
+        auto result = words[index] >> shift;
+        if (shift != 0 && index + 1 < words.size())
+        {
+            result |= words[index + 1] << (bits_per_word - shift);
+        }
+        return result;
+    }
+
+    // target[target_position + i] |= source[source_position + i] for i in [0, count), one word at a time.
+    inline void or_bits(const std::span<uint64_t> target, const size_t target_position,
+        const std::span<const uint64_t> source, const size_t source_position, const size_t count)
+    {
+        size_t done = 0;
+        while (done < count)
+        {
+            const auto position = target_position + done;
+            const auto index = position / bits_per_word;
+            const auto shift = position % bits_per_word;
+            const auto chunk = std::min(bits_per_word - shift, count - done);
+
+            const auto bits = read_word_at(source, source_position + done) & low_bits_mask(chunk);
+            target[index] |= bits << shift;
+            done += chunk;
+        }
+    }
+
+    // Reverses the order of all bits in `source` into `target` of the same size: bit i moves to bit (64 * size - 1 - i).
+    inline void reverse_words(const std::span<const uint64_t> source, const std::span<uint64_t> target)
+    {
+        for (size_t i = 0; i < source.size(); i++)
+        {
+            target[source.size() - 1 - i] = reverse_bits(source[i]);
+        }
+    }
+
+    // Bit-packed 2D bitset. Every row is a contiguous run of 64-bit words in an Array2, bit x of a row is bit (x % 64) of word (x / 64).
+    // Bits past the width are always zero, so rows can be combined and counted a word at a time.
+    class BitArray2
+    {
+
+    public:
+
+        BitArray2() = default;
+
+        explicit BitArray2(const Vector2s size) :
+            m_size(size),
+            m_words(make_array2<uint64_t>(Vector2s{ (size.x + bits_per_word - 1) / bits_per_word, size.y }))
+        {}
+
+        const Vector2s& get_size() const
+        {
+            return m_size;
+        }
+
+        size_t get_words_per_row() const
+        {
+            return m_words.size.x;
+        }
+
+        bool get(const size_t x, const size_t y) const
+        {
+            return (m_words(x / bits_per_word, y) >> (x % bits_per_word)) & 1;
+        }
+
+        void set(const size_t x, const size_t y, const bool value = true)
+        {
+            auto& word = m_words(x / bits_per_word, y);
+            const auto mask = uint64_t{ 1 } << (x % bits_per_word);
+            word = value ? (word | mask) : (word & ~mask);
+        }
+
+        std::span<uint64_t> row(const size_t y)
+        {
+            return m_words.row(y);
+        }
+
+        std::span<const uint64_t> row(const size_t y) const
+        {
+            return m_words.row(y);
+        }
+
+        // Row y |= source, word by word. Source must not be wider than this array.
+        void or_row(const size_t y, const std::span<const uint64_t> source)
+        {
+            auto target = row(y);
+            for (size_t i = 0; i < source.size(); i++)
+            {
+                target[i] |= source[i];
+            }
+        }
+
+        // Mirrors bits [first, first + count) of the source row into row y, ending right before target_end:
+        // source bit first + i is ORed into bit target_end - 1 - i.
+        void or_reversed_row(const size_t y, const std::span<const uint64_t> source, const size_t first, const size_t count, const size_t target_end)
+        {
+            m_reverse_buffer.resize(source.size());
+            reverse_words(source, m_reverse_buffer);
+
+            const auto reversed_first = source.size() * bits_per_word - first - count;
+            or_bits(row(y), target_end - count, m_reverse_buffer, reversed_first, count);
+        }
+
+        // Copy of the rectangle at `position`, e.g. a range of rows or columns.
+        BitArray2 slice(const Vector2s position, const Vector2s size) const
+        {
+            BitArray2 result(size);
+            for (size_t y = 0; y < size.y; y++)
+            {
+                or_bits(result.row(y), 0, row(position.y + y), position.x, size.x);
+            }
+            return result;
+        }
+
+        // Keeps the bits inside both sizes and clears the rest. Reuses the storage unless the array grows past it.
+        void resize(const Vector2s size)
+        {
+            if (size.x > get_words_per_row() * bits_per_word || size.y > m_words.size.y)
+            {
+                BitArray2 result(size);
+                for (size_t y = 0; y < std::min(size.y, m_size.y); y++)
+                {
+                    or_bits(result.row(y), 0, row(y), 0, std::min(size.x, m_size.x));
+                }
+                *this = std::move(result);
+                return;
+            }
+
+            const auto full_words = size.x / bits_per_word;
+            const auto remaining_bits = size.x % bits_per_word;
+            for (size_t y = 0; y < size.y; y++)
+            {
+                auto words = row(y);
+                if (y >= m_size.y)
+                {
+                    std::fill(words.begin(), words.end(), uint64_t{ 0 });
+                    continue;
+                }
+                if (remaining_bits != 0)
+                {
+                    words[full_words] &= low_bits_mask(remaining_bits);
+                }
+                std::fill(words.begin() + full_words + (remaining_bits != 0 ? 1 : 0), words.end(), uint64_t{ 0 });
+            }
+            m_size = size;
+        }
+
+        size_t count() const
+        {
+            size_t result = 0;
+            for (size_t y = 0; y < m_size.y; y++)
+            {
+                for (const auto word : row(y))
+                {
+                    result += static_cast<size_t>(std::popcount(word));
+                }
+            }
+            return result;
+        }
+
+    private:
+
+        Vector2s m_size = {};
+        Array2<uint64_t> m_words;
+        std::vector<uint64_t> m_reverse_buffer;
+
+    };
+
+}
+
+#endif
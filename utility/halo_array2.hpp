@@ -0,0 +1,207 @@
+#ifndef AOC_UTILITY_HALO_ARRAY2_HPP
+#define AOC_UTILITY_HALO_ARRAY2_HPP
+
+#include "array2.hpp"
+#include <array>
+#include <cstddef>
+#include <algorithm>
+
+namespace aoc
+{
+
+    inline constexpr std::array<Vector2i32, 4> orthogonal_offsets = {
+        Vector2i32{ -1, 0 }, Vector2i32{ 1, 0 }, Vector2i32{ 0, -1 }, Vector2i32{ 0, 1 }
+    };
+
+    inline constexpr std::array<Vector2i32, 8> adjacent_offsets = {
+        Vector2i32{ -1, -1 }, Vector2i32{ 0, -1 }, Vector2i32{ 1, -1 },
+        Vector2i32{ -1, 0 }, Vector2i32{ 1, 0 },
+        Vector2i32{ -1, 1 }, Vector2i32{ 0, 1 }, Vector2i32{ 1, 1 }
+    };
+
+    // Linear distances between an element and its neighbours, valid for one stride.
+    template<size_t VCount>
+    using NeighbourOffsets = std::array<ptrdiff_t, VCount>;
+
+    template<size_t VCount>
+    NeighbourOffsets<VCount> make_neighbour_offsets(const std::array<Vector2i32, VCount>& offsets, const size_t stride)
+    {
+        NeighbourOffsets<VCount> result = {};
+        for (size_t i = 0; i < VCount; i++)
+        {
+            result[i] = static_cast<ptrdiff_t>(offsets[i].y) * static_cast<ptrdiff_t>(stride) + offsets[i].x;
+        }
+        return result;
+    }
+
+    // Array2 surrounded by a border of `halo` elements holding a sentinel value.
+    // Neighbours of interior elements that are at most `halo` steps away can be read without bounds checks.
+    // Elements are addressed by interior coordinates in any layout, or by linear indices into the padded storage in the row-major layout.
+    template<typename T, typename TLayout = RowMajorLayout>
+    struct HaloArray2
+    {
+        using Type = T;
+        using Layout = TLayout;
+
+        Vector2s size = {};
+        size_t halo = 0;
+        Array2<T, TLayout> storage;
+
+        T& operator () (const size_t x, const size_t y)
+        {
+            return storage(x + halo, y + halo);
+        }
+
+        const T& operator () (const size_t x, const size_t y) const
+        {
+            return storage(x + halo, y + halo);
+        }
+
+        T& operator [] (const size_t index) requires TLayout::is_row_major
+        {
+            return storage.data[index];
+        }
+
+        const T& operator [] (const size_t index) const requires TLayout::is_row_major
+        {
+            return storage.data[index];
+        }
+
+        size_t get_stride() const requires TLayout::is_row_major
+        {
+            return storage.size.x;
+        }
+
+        size_t get_index(const size_t x, const size_t y) const requires TLayout::is_row_major
+        {
+            return (y + halo) * storage.size.x + x + halo;
+        }
+
+        Vector2s get_position(const size_t index) const requires TLayout::is_row_major
+        {
+            return { index % storage.size.x - halo, index / storage.size.x - halo };
+        }
+
+        std::span<T> row(const size_t y) requires TLayout::is_row_major
+        {
+            return storage.row(y + halo).subspan(halo, size.x);
+        }
+
+        std::span<const T> row(const size_t y) const requires TLayout::is_row_major
+        {
+            return storage.row(y + halo).subspan(halo, size.x);
+        }
+
+        Array2View<T> interior() requires TLayout::is_row_major
+        {
+            return storage.subview({ halo, halo }, size);
+        }
+
+        Array2View<const T> interior() const requires TLayout::is_row_major
+        {
+            return storage.subview({ halo, halo }, size);
+        }
+
+        template<size_t VCount>
+        NeighbourOffsets<VCount> get_neighbour_offsets(const std::array<Vector2i32, VCount>& offsets) const requires TLayout::is_row_major
+        {
+            return make_neighbour_offsets(offsets, get_stride());
+        }
+
+        void fill_halo(const T& sentinel)
+        {
+            if constexpr (TLayout::is_row_major)
+            {
+                for (size_t y = 0; y < storage.size.y; y++)
+                {
+                    auto row = storage.row(y);
+                    if (y < halo || y >= halo + size.y)
+                    {
+                        std::fill(row.begin(), row.end(), sentinel);
+                        continue;
+                    }
+                    std::fill(row.begin(), row.begin() + halo, sentinel);
+                    std::fill(row.end() - halo, row.end(), sentinel);
+                }
+                return;
+            }
+
+            for (size_t y = 0; y < storage.size.y; y++)
+            {
+                const bool is_halo_row = y < halo || y >= halo + size.y;
+                for (size_t x = 0; x < storage.size.x; x++)
+                {
+                    if (is_halo_row || x < halo || x >= halo + size.x)
+                    {
+                        storage(x, y) = sentinel;
+                    }
+                }
+            }
+        }
+
+        bool is_outside(const Vector2i32 position) const
+        {
+            return position.x < 0 || position.y < 0 || position.x >= size.x || position.y >= size.y;
+        }
+
+    };
+
+    // Interior is value initialised, the halo is set to the sentinel.
+    template<typename T, typename TLayout = RowMajorLayout>
+    HaloArray2<T, TLayout> make_halo_array2(const Vector2s size, const size_t halo, const T& sentinel)
+    {
+        HaloArray2<T, TLayout> result{ size, halo, make_array2<T, TLayout>(Vector2s{ size.x + 2 * halo, size.y + 2 * halo }) };
+        result.fill_halo(sentinel);
+        return result;
+    }
+
+    // Calls callback(neighbour_index, neighbour) for every offset around the element at a linear index.
+    template<typename T, size_t VCount, typename TCallback>
+    void for_each_neighbour(HaloArray2<T>& array2, const size_t index, const NeighbourOffsets<VCount>& offsets, TCallback&& callback)
+    {
+        for (const auto offset : offsets)
+        {
+            const auto neighbour_index = static_cast<size_t>(static_cast<ptrdiff_t>(index) + offset);
+            callback(neighbour_index, array2[neighbour_index]);
+        }
+    }
+
+    template<typename T, size_t VCount, typename TCallback>
+    void for_each_neighbour(const HaloArray2<T>& array2, const size_t index, const NeighbourOffsets<VCount>& offsets, TCallback&& callback)
+    {
+        for (const auto offset : offsets)
+        {
+            const auto neighbour_index = static_cast<size_t>(static_cast<ptrdiff_t>(index) + offset);
+            callback(neighbour_index, array2[neighbour_index]);
+        }
+    }
+
+    // Calls callback(position, element) for every offset around an interior position, in any layout.
+    // Positions left of or above the interior wrap around and are mapped back into the halo by operator ().
+    template<typename T, typename TLayout, size_t VCount, typename TCallback>
+    void for_each_neighbour(HaloArray2<T, TLayout>& array2, const Vector2s position, const std::array<Vector2i32, VCount>& offsets, TCallback&& callback)
+    {
+        for (const auto offset : offsets)
+        {
+            const auto neighbour = Vector2s{ position.x + static_cast<size_t>(offset.x), position.y + static_cast<size_t>(offset.y) };
+            callback(neighbour, array2(neighbour.x, neighbour.y));
+        }
+    }
+
+    // Calls callback(index, element) for every interior element, row by row.
+    template<typename TArray, typename TCallback>
+    void for_each_interior_index(TArray& array2, TCallback&& callback)
+    {
+        for (size_t y = 0; y < array2.size.y; y++)
+        {
+            const auto row_begin = array2.get_index(0, y);
+            for (size_t index = row_begin; index < row_begin + array2.size.x; index++)
+            {
+                callback(index, array2[index]);
+            }
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,10 @@
+#include "utility.hpp"
+#include "allocation_hooks.hpp"
+
+// Shared entry point of every executable. Days register their solvers with aoc::register_puzzle.
+int main(int argc, char** argv)
+{
+    aoc::parse_options(argc, argv);
+
+    return aoc::run_puzzles();
+}
@@ -0,0 +1,265 @@
+#ifndef AOC_UTILITY_MAPPED_FILE_HPP
+#define AOC_UTILITY_MAPPED_FILE_HPP
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <utility>
+#include "tokenizer.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aoc
+{
+
+    // Read-only memory mapping of a whole file. Views returned by view() are valid for the lifetime of the mapping.
+    class mapped_file
+    {
+
+    public:
+
+        mapped_file() = default;
+
+        ~mapped_file()
+        {
+            close();
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator = (const mapped_file&) = delete;
+
+        mapped_file(mapped_file&& rhs) noexcept
+        {
+            swap(rhs);
+        }
+
+        mapped_file& operator = (mapped_file&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                close();
+                swap(rhs);
+            }
+            return *this;
+        }
+
+        bool open(const std::string& filename)
+        {
+            close();
+
+#if defined(_WIN32)
+            m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+
+            LARGE_INTEGER file_size = {};
+            if (!GetFileSizeEx(m_file, &file_size))
+            {
+                close();
+                return false;
+            }
+
+            m_size = static_cast<size_t>(file_size.QuadPart);
+            m_is_open = true;
+            if (m_size == 0)
+            {
+                return true;
+            }
+
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_mapping == nullptr)
+            {
+                close();
+                return false;
+            }
+
+            m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (m_data == nullptr)
+            {
+                close();
+                return false;
+            }
+#else
+            m_file = ::open(filename.c_str(), O_RDONLY);
+            if (m_file < 0)
+            {
+                return false;
+            }
+
+            struct stat file_stat = {};
+            if (::fstat(m_file, &file_stat) != 0)
+            {
+                close();
+                return false;
+            }
+
+            m_size = static_cast<size_t>(file_stat.st_size);
+            m_is_open = true;
+            if (m_size == 0)
+            {
+                return true;
+            }
+
+            void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+            if (data == MAP_FAILED)
+            {
+                close();
+                return false;
+            }
+
+            ::madvise(data, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(data);
+#endif
+            return true;
+        }
+
+        void close()
+        {
+#if defined(_WIN32)
+            if (m_data != nullptr)
+            {
+                UnmapViewOfFile(m_data);
+            }
+            if (m_mapping != nullptr)
+            {
+                CloseHandle(m_mapping);
+            }
+            if (m_file != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_file);
+            }
+            m_mapping = nullptr;
+            m_file = INVALID_HANDLE_VALUE;
+#else
+            if (m_data != nullptr)
+            {
+                ::munmap(const_cast<char*>(m_data), m_size);
+            }
+            if (m_file >= 0)
+            {
+                ::close(m_file);
+            }
+            m_file = -1;
+#endif
+            m_data = nullptr;
+            m_size = 0;
+            m_is_open = false;
+        }
+
+        bool is_open() const
+        {
+            return m_is_open;
+        }
+
+        std::string_view view() const
+        {
+            return { m_data, m_size };
+        }
+
+        size_t size() const
+        {
+            return m_size;
+        }
+
+    private:
+
+        void swap(mapped_file& rhs) noexcept
+        {
+            std::swap(m_file, rhs.m_file);
+#if defined(_WIN32)
+            std::swap(m_mapping, rhs.m_mapping);
+#endif
+            std::swap(m_data, rhs.m_data);
+            std::swap(m_size, rhs.m_size);
+            std::swap(m_is_open, rhs.m_is_open);
+        }
+
+#if defined(_WIN32)
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#else
+        int m_file = -1;
+#endif
+        const char* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_is_open = false;
+
+    };
+
+
+    // Drops the cached pages of a file, so the next read of it comes from the disk. Returns false if unsupported or failed.
+    inline bool evict_file_cache(const std::string& filename)
+    {
+#if defined(__linux__)
+        const auto file = ::open(filename.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+
+        const auto result = ::posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(file);
+        return result == 0;
+#else
+        (void)filename;
+        return false;
+#endif
+    }
+
+
+    // Splits text into lines the same way std::getline does. Carriage returns are stripped, since mappings are binary.
+    // Newlines are found 64 bytes at a time by the vectorised tokenizer.
+    template<typename TCallback>
+    void for_each_line(std::string_view text, TCallback&& callback)
+    {
+        auto emit_line = [&callback](std::string_view line)
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            callback(line);
+        };
+
+        size_t begin = 0;
+        for_each_byte(text, '\n', [&](const size_t end)
+        {
+            emit_line(text.substr(begin, end - begin));
+            begin = end + 1;
+        });
+        emit_line(text.substr(begin));
+    }
+
+    // Splits text into whitespace separated words the same way operator >> does.
+    template<typename TCallback>
+    void for_each_word(std::string_view text, TCallback&& callback)
+    {
+        constexpr std::string_view whitespace = " \t\r\n\v\f";
+
+        size_t begin = text.find_first_not_of(whitespace);
+        while (begin != std::string_view::npos)
+        {
+            const auto end = text.find_first_of(whitespace, begin);
+            callback(text.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin));
+            begin = text.find_first_not_of(whitespace, end);
+        }
+    }
+
+}
+
+#endif
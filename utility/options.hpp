@@ -0,0 +1,266 @@
+#ifndef AOC_UTILITY_OPTIONS_HPP
+#define AOC_UTILITY_OPTIONS_HPP
+
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <charconv>
+#include <cstdlib>
+
+namespace aoc
+{
+
+    struct options
+    {
+        bool benchmark = false;
+        size_t warmup_iterations = 3;
+        size_t iterations = 25;
+        std::string export_filename;
+        std::string baseline_filename;
+        double regression_threshold = 10.0;
+        size_t worker_count = 0; // Zero uses every logical processor.
+        bool pin_workers = false;
+        bool perf_counters = false;
+        std::string trace_filename;
+        std::string profile_directory; // Collapsed stacks of sampled parts are written here.
+        size_t profile_frequency = 1000; // Samples per second of CPU time.
+        std::string input_filename;
+        std::string input_directory;
+        bool stream = false;
+        size_t stream_budget = 1024 * 1024; // Bytes.
+        size_t parallel_worker_count = 1; // Threads of the task scheduler and parallel grid loops within a part. Zero uses every logical processor.
+        size_t parallel_grain = 0; // Rows per chunk of parallel grid loops. Zero picks it from the grid size.
+        bool binary_input = false;
+        bool use_cache = false; // Reuse results of unchanged inputs and solvers, with --cache.
+        bool verify_cache = false;
+        std::string cache_directory = "aoc_cache";
+        std::string batch_path; // Directory or manifest of inputs solved by a single day.
+        size_t read_ahead = 0; // Inputs read but not yet solved in a batch run or with prefetch. Zero reads one ahead per worker.
+        bool prefetch = false; // Read and parse inputs on a background thread ahead of the solving workers.
+        bool evict_inputs = false;
+    };
+
+    inline options& get_options()
+    {
+        static options instance;
+        return instance;
+    }
+
+    inline void print_usage(const char* program)
+    {
+        std::cout <<
+            "Usage: " << program << " [options]\n"
+            "  --input <file>       Read the input of a single day from this file.\n"
+            "  --input-dir <dir>    Read day_<N>_input.txt files from this directory. Default: ../inputs.\n"
+            "  --benchmark          Run every part repeatedly and print timing statistics.\n"
+            "  --warmup <count>     Number of untimed benchmark iterations. Default: 3.\n"
+            "  --iterations <count> Number of timed benchmark iterations. Default: 25.\n"
+            "  --export <file>      Write read and part timings to a .json or .csv file.\n"
+            "  --baseline <file>    Compare benchmark timings to a .csv report and fail on regressions.\n"
+            "  --threshold <pct>    Allowed slowdown compared to the baseline, in percent. Default: 10.\n"
+            "  --perf               Count cycles, instructions, cache and branch misses of every part (Linux).\n"
+            "  --trace <file>       Write trace scopes as a Chrome trace (requires AOC_ENABLE_TRACE).\n"
+            "  --profile <dir>      Sample every part and write its collapsed stacks to <dir>/day_<N>_part_<P>.folded (requires AOC_ENABLE_PROFILER, Linux).\n"
+            "  --profile-frequency <hz> Samples per second of CPU time when profiling. Default: 1000.\n"
+            "  --threads <count>    Number of workers when running several days. Default: all processors.\n"
+            "  --pin                Pin every worker thread to its own processor.\n"
+            "  --stream             Use the streaming variant of parts that have one, reading the input in chunks.\n"
+            "  --stream-budget <KiB> Memory budget of a streaming part. Default: 1024.\n"
+            "  --binary             Load day_<N>_input.bin grids written by convert_grid, for days that support it.\n"
+            "  --grid-threads <count> Threads of the task scheduler and parallel grid loops within a part, 0 for all processors. Default: 1.\n"
+            "  --grain <rows>       Rows per chunk of parallel grid loops. Default: picked from the grid size.\n"
+            "  --cache              Print the cached results of unchanged inputs and solvers instead of solving, and cache new ones.\n"
+            "  --verify-cache       Solve, compare the results to the cached ones and fail on a mismatch.\n"
+            "  --cache-dir <dir>    Directory of cached results. Default: aoc_cache.\n"
+            "  --batch <path>       Solve every input file of a directory, or listed in a manifest, with --threads workers.\n"
+            "  --read-ahead <count> Inputs read ahead of the solving workers in batch runs and with --prefetch. Default: one per worker.\n"
+            "  --prefetch           Read and parse inputs on a background thread while the workers solve, for batch runs and several days.\n"
+            "  --evict-inputs       Drop input files from the page cache before the run, to measure cold reads (Linux).\n"
+            "  --help               Print this message.\n";
+    }
+
+    // Parses command line arguments into get_options(). Exits the process on invalid arguments.
+    inline void parse_options(int argc, char** argv)
+    {
+        auto& result = get_options();
+
+        auto fail = [&](const std::string& message)
+        {
+            std::cerr << "parse_options: " << message << "\n";
+            print_usage(argv[0]);
+            std::exit(EXIT_FAILURE);
+        };
+
+        auto next_value = [&](int& index) -> std::string_view
+        {
+            if (index + 1 >= argc)
+            {
+                fail(std::string("Missing value for ") + argv[index]);
+            }
+            return argv[++index];
+        };
+
+        auto next_count = [&](int& index) -> size_t
+        {
+            const auto value = next_value(index);
+            size_t count = 0;
+            auto parse_result = std::from_chars(value.data(), value.data() + value.size(), count);
+            if (parse_result.ec != std::errc() || parse_result.ptr != value.data() + value.size())
+            {
+                fail("Invalid count: " + std::string(value));
+            }
+            return count;
+        };
+
+        for (int i = 1; i < argc; i++)
+        {
+            const std::string_view argument = argv[i];
+
+            if (argument == "--input")
+            {
+                result.input_filename = next_value(i);
+            }
+            else if (argument == "--input-dir")
+            {
+                result.input_directory = next_value(i);
+            }
+            else if (argument == "--benchmark")
+            {
+                result.benchmark = true;
+            }
+            else if (argument == "--warmup")
+            {
+                result.warmup_iterations = next_count(i);
+            }
+            else if (argument == "--iterations")
+            {
+                result.iterations = next_count(i);
+                if (result.iterations == 0)
+                {
+                    fail("Iteration count must be at least 1.");
+                }
+            }
+            else if (argument == "--export")
+            {
+                result.export_filename = next_value(i);
+            }
+            else if (argument == "--baseline")
+            {
+                result.baseline_filename = next_value(i);
+            }
+            else if (argument == "--threshold")
+            {
+                const auto value = next_value(i);
+                auto parse_result = std::from_chars(value.data(), value.data() + value.size(), result.regression_threshold);
+                if (parse_result.ec != std::errc() || parse_result.ptr != value.data() + value.size() || result.regression_threshold < 0.0)
+                {
+                    fail("Invalid threshold: " + std::string(value));
+                }
+            }
+            else if (argument == "--threads")
+            {
+                result.worker_count = next_count(i);
+            }
+            else if (argument == "--pin")
+            {
+                result.pin_workers = true;
+            }
+            else if (argument == "--perf")
+            {
+                result.perf_counters = true;
+            }
+            else if (argument == "--trace")
+            {
+                result.trace_filename = next_value(i);
+#if !defined(AOC_ENABLE_TRACE)
+                fail("Tracing requires building with the AOC_ENABLE_TRACE CMake option.");
+#endif
+            }
+            else if (argument == "--profile")
+            {
+                result.profile_directory = next_value(i);
+#if !defined(AOC_ENABLE_PROFILER) || !defined(__linux__)
+                fail("Profiling requires Linux and building with the AOC_ENABLE_PROFILER CMake option.");
+#endif
+            }
+            else if (argument == "--profile-frequency")
+            {
+                result.profile_frequency = next_count(i);
+                if (result.profile_frequency == 0 || result.profile_frequency > 100000)
+                {
+                    fail("Profile frequency must be between 1 and 100000 Hz.");
+                }
+            }
+            else if (argument == "--stream")
+            {
+                result.stream = true;
+            }
+            else if (argument == "--stream-budget")
+            {
+                result.stream_budget = next_count(i) * 1024;
+                if (result.stream_budget == 0)
+                {
+                    fail("Stream budget must be at least 1 KiB.");
+                }
+            }
+            else if (argument == "--binary")
+            {
+                result.binary_input = true;
+            }
+            else if (argument == "--grid-threads")
+            {
+                result.parallel_worker_count = next_count(i);
+            }
+            else if (argument == "--grain")
+            {
+                result.parallel_grain = next_count(i);
+            }
+            else if (argument == "--cache")
+            {
+                result.use_cache = true;
+            }
+            else if (argument == "--verify-cache")
+            {
+                result.verify_cache = true;
+            }
+            else if (argument == "--cache-dir")
+            {
+                result.cache_directory = next_value(i);
+            }
+            else if (argument == "--batch")
+            {
+                result.batch_path = next_value(i);
+            }
+            else if (argument == "--read-ahead")
+            {
+                result.read_ahead = next_count(i);
+            }
+            else if (argument == "--prefetch")
+            {
+                result.prefetch = true;
+            }
+            else if (argument == "--evict-inputs")
+            {
+                result.evict_inputs = true;
+            }
+            else if (argument == "--help")
+            {
+                print_usage(argv[0]);
+                std::exit(EXIT_SUCCESS);
+            }
+            else
+            {
+                fail("Unknown argument: " + std::string(argument));
+            }
+        }
+
+        // Only medians of several benchmark iterations are gated, a comparison of single samples could never fail.
+        if (!result.baseline_filename.empty() && (!result.benchmark || result.iterations < 2))
+        {
+            fail("--baseline requires --benchmark with at least 2 iterations.");
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef AOC_UTILITY_PARALLEL_HPP
+#define AOC_UTILITY_PARALLEL_HPP
+
+#include "task_scheduler.hpp"
+#include "array2.hpp"
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+// Row-partitioned parallel loops over index ranges and Array2 grids.
+// Ranges are split into chunks of `grain` indices, claimed by the calling thread and tasks of the shared task_scheduler.
+// Results of parallel_reduce are combined in chunk order, so they do not depend on the number of threads.
+namespace aoc
+{
+
+    // Smallest amount of elements worth handing to another thread.
+    inline constexpr size_t parallel_min_chunk_elements = 16 * 1024;
+
+    // Grain, in indices of `count` items of `item_elements` elements each.
+    // Zero picks about four chunks per thread, but not less than parallel_min_chunk_elements elements per chunk.
+    inline size_t get_parallel_grain(const size_t count, const size_t item_elements, const size_t grain = 0)
+    {
+        if (grain != 0)
+        {
+            return grain;
+        }
+        if (get_options().parallel_grain != 0)
+        {
+            return get_options().parallel_grain;
+        }
+
+        const auto min_grain = (parallel_min_chunk_elements + item_elements - 1) / std::max(item_elements, size_t{ 1 });
+        const auto balanced_grain = (count + 4 * get_parallel_thread_count() - 1) / (4 * get_parallel_thread_count());
+        return std::max({ size_t{ 1 }, min_grain, balanced_grain });
+    }
+
+    // Calls function(chunk_index, chunk_begin, chunk_end) for consecutive chunks of [begin, end). Returns the number of chunks.
+    template<typename TFunction>
+    size_t parallel_for_chunks(const size_t begin, const size_t end, const size_t grain, TFunction&& function)
+    {
+        if (begin >= end)
+        {
+            return 0;
+        }
+
+        const auto chunk_size = std::max(grain, size_t{ 1 });
+        const auto chunk_count = (end - begin + chunk_size - 1) / chunk_size;
+        const auto thread_count = std::min(get_parallel_thread_count(), chunk_count);
+
+        if (thread_count <= 1)
+        {
+            for (size_t chunk = 0; chunk < chunk_count; chunk++)
+            {
+                function(chunk, begin + chunk * chunk_size, std::min(end, begin + (chunk + 1) * chunk_size));
+            }
+            return chunk_count;
+        }
+
+        // Helpers that start after the loop is done find no chunks left and never touch `function`.
+        std::atomic<size_t> next_chunk = 0;
+        auto run_chunks = [&next_chunk, begin, end, chunk_size, chunk_count, &function]()
+        {
+            for (auto chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++)
+            {
+                function(chunk, begin + chunk * chunk_size, std::min(end, begin + (chunk + 1) * chunk_size));
+            }
+        };
+
+        task_group group(get_task_scheduler());
+        for (size_t i = 1; i < thread_count; i++)
+        {
+            group.spawn(run_chunks);
+        }
+        run_chunks();
+        group.sync();
+        return chunk_count;
+    }
+
+    // Calls function(chunk_begin, chunk_end) for chunks of [begin, end), in parallel.
+    template<typename TFunction>
+    void parallel_for(const size_t begin, const size_t end, TFunction&& function, const size_t grain = 0)
+    {
+        parallel_for_chunks(begin, end, get_parallel_grain(end - begin, 1, grain), [&function](size_t, const size_t chunk_begin, const size_t chunk_end)
+        {
+            function(chunk_begin, chunk_end);
+        });
+    }
+
+    // Calls function(y, row) for every row of a row-major Array2, or any grid with `size` and row(y), in parallel. Grain is in rows.
+    template<typename TArray, typename TFunction>
+    void parallel_for_rows(TArray& array2, TFunction&& function, const size_t grain = 0)
+    {
+        parallel_for_chunks(0, array2.size.y, get_parallel_grain(array2.size.y, array2.size.x, grain), [&array2, &function](size_t, const size_t row_begin, const size_t row_end)
+        {
+            for (size_t y = row_begin; y < row_end; y++)
+            {
+                function(y, array2.row(y));
+            }
+        });
+    }
+
+    // Maps every chunk of [begin, end) with map_chunk(chunk_begin, chunk_end) and folds the results in order with reduce(lhs, rhs).
+    // item_elements is the amount of work per index, used to pick the automatic grain.
+    template<typename TValue, typename TMap, typename TReduce>
+    TValue parallel_reduce(const size_t begin, const size_t end, TValue initial, TMap&& map_chunk, TReduce&& reduce,
+        const size_t grain = 0, const size_t item_elements = 1)
+    {
+        const auto chunk_grain = get_parallel_grain(end - begin, item_elements, grain);
+        const auto chunk_count = end > begin ? (end - begin + chunk_grain - 1) / chunk_grain : 0;
+
+        std::vector<TValue> chunk_results(chunk_count);
+        parallel_for_chunks(begin, end, chunk_grain, [&](const size_t chunk, const size_t chunk_begin, const size_t chunk_end)
+        {
+            chunk_results[chunk] = map_chunk(chunk_begin, chunk_end);
+        });
+
+        for (auto& chunk_result : chunk_results)
+        {
+            initial = reduce(std::move(initial), std::move(chunk_result));
+        }
+        return initial;
+    }
+
+    // One step of a stencil: target(x, y) = kernel(source, x, y) for every element, rows in parallel.
+    template<typename T, typename TKernel>
+    void parallel_stencil(const Array2<T>& source, Array2<T>& target, TKernel&& kernel, const size_t grain = 0)
+    {
+        parallel_for_rows(target, [&source, &kernel](const size_t y, const std::span<T> row)
+        {
+            for (size_t x = 0; x < row.size(); x++)
+            {
+                row[x] = kernel(source, x, y);
+            }
+        }, grain);
+    }
+
+    // Runs `steps` stencil steps, swapping the buffers after every step. The result ends up in `current`.
+    template<typename T, typename TKernel>
+    void parallel_stencil(Array2<T>& current, Array2<T>& next, const size_t steps, TKernel&& kernel, const size_t grain = 0)
+    {
+        for (size_t step = 0; step < steps; step++)
+        {
+            parallel_stencil(current, next, kernel, grain);
+            std::swap(current, next);
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef AOC_UTILITY_PERF_COUNTERS_HPP
+#define AOC_UTILITY_PERF_COUNTERS_HPP
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <ostream>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aoc
+{
+
+    enum class perf_counter
+    {
+        cycles,
+        instructions,
+        l1d_read_misses,
+        llc_read_misses,
+        branch_misses
+    };
+
+    inline constexpr size_t perf_counter_count = 5;
+
+    inline const char* get_perf_counter_name(const perf_counter counter)
+    {
+        switch (counter)
+        {
+        case perf_counter::cycles: return "cycles";
+        case perf_counter::instructions: return "instructions";
+        case perf_counter::l1d_read_misses: return "l1d_misses";
+        case perf_counter::llc_read_misses: return "llc_misses";
+        case perf_counter::branch_misses: return "branch_misses";
+        }
+        return "unknown";
+    }
+
+    struct perf_counter_values
+    {
+        std::array<bool, perf_counter_count> available = {};
+        std::array<uint64_t, perf_counter_count> values = {}; // Scaled to the whole enabled time if the group was multiplexed.
+        uint64_t time_enabled = 0; // Nanoseconds the group was enabled.
+        uint64_t time_running = 0; // Nanoseconds the group was actually counting on a processor.
+        size_t uncounted_workers = 0; // Task scheduler workers the part may have handed work to, whose events are not counted.
+
+        bool is_available(const perf_counter counter) const
+        {
+            return available[static_cast<size_t>(counter)];
+        }
+
+        uint64_t get(const perf_counter counter) const
+        {
+            return values[static_cast<size_t>(counter)];
+        }
+
+        bool any_available() const
+        {
+            for (const auto counter_available : available)
+            {
+                if (counter_available)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // The kernel time-shared the counters with other events, and the values are estimates scaled from the running time.
+        bool is_multiplexed() const
+        {
+            return time_running < time_enabled;
+        }
+
+        double get_running_fraction() const
+        {
+            return time_enabled != 0 ? static_cast<double>(time_running) / static_cast<double>(time_enabled) : 1.0;
+        }
+
+        double get_instructions_per_cycle() const
+        {
+            if (!is_available(perf_counter::cycles) || !is_available(perf_counter::instructions) || get(perf_counter::cycles) == 0)
+            {
+                return 0.0;
+            }
+            return static_cast<double>(get(perf_counter::instructions)) / static_cast<double>(get(perf_counter::cycles));
+        }
+
+        perf_counter_values divided_by(const uint64_t divisor) const
+        {
+            auto result = *this;
+            for (auto& value : result.values)
+            {
+                value /= divisor == 0 ? 1 : divisor;
+            }
+            return result;
+        }
+    };
+
+    // Hardware counters of the calling thread, excluding kernel time. Counters the kernel refuses to open are left out.
+    // All counters form one group, which the kernel schedules onto the processor as a whole, so they always cover the same
+    // time window and their ratios hold even when the group is multiplexed with other events.
+    class perf_counters
+    {
+
+    public:
+
+        perf_counters()
+        {
+            m_files.fill(-1);
+#if defined(__linux__)
+            open_counter(perf_counter::cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            open_counter(perf_counter::instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            open_counter(perf_counter::l1d_read_misses, PERF_TYPE_HW_CACHE, get_cache_config(PERF_COUNT_HW_CACHE_L1D));
+            open_counter(perf_counter::llc_read_misses, PERF_TYPE_HW_CACHE, get_cache_config(PERF_COUNT_HW_CACHE_LL));
+            open_counter(perf_counter::branch_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#else
+            m_error = "perf_event_open is only available on Linux";
+#endif
+        }
+
+        ~perf_counters()
+        {
+#if defined(__linux__)
+            for (const auto file : m_files)
+            {
+                if (file >= 0)
+                {
+                    ::close(file);
+                }
+            }
+#endif
+        }
+
+        perf_counters(const perf_counters&) = delete;
+        perf_counters& operator = (const perf_counters&) = delete;
+
+        bool is_available() const
+        {
+            for (const auto file : m_files)
+            {
+                if (file >= 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Reason the first counter failed to open, if any.
+        const std::string& get_error() const
+        {
+            return m_error;
+        }
+
+        // Counting accumulates over every start/stop pair.
+        void start()
+        {
+#if defined(__linux__)
+            if (m_leader >= 0)
+            {
+                ::ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        void stop()
+        {
+#if defined(__linux__)
+            if (m_leader >= 0)
+            {
+                ::ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        // Values of the whole group, scaled by time enabled / time running if the group was multiplexed.
+        // Nothing is available if the group was never scheduled.
+        perf_counter_values read() const
+        {
+            perf_counter_values result;
+#if defined(__linux__)
+            if (m_leader < 0)
+            {
+                return result;
+            }
+
+            // PERF_FORMAT_GROUP layout: count, time enabled, time running, then one value per counter in the order they joined.
+            std::vector<uint64_t> buffer(3 + m_group.size());
+            const auto size = static_cast<ssize_t>(buffer.size() * sizeof(uint64_t));
+            if (::read(m_leader, buffer.data(), static_cast<size_t>(size)) != size || buffer[0] != m_group.size())
+            {
+                return result;
+            }
+
+            result.time_enabled = buffer[1];
+            result.time_running = buffer[2];
+            if (result.time_running == 0)
+            {
+                return result;
+            }
+
+            const auto scale = static_cast<long double>(result.time_enabled) / static_cast<long double>(result.time_running);
+            for (size_t i = 0; i < m_group.size(); i++)
+            {
+                const auto counter = m_group[i];
+                const auto value = buffer[3 + i];
+                result.available[counter] = true;
+                result.values[counter] = result.is_multiplexed() ? static_cast<uint64_t>(static_cast<long double>(value) * scale) : value;
+            }
+#endif
+            return result;
+        }
+
+    private:
+
+#if defined(__linux__)
+        static uint64_t get_cache_config(const uint64_t cache)
+        {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+
+        void open_counter(const perf_counter counter, const uint32_t type, const uint64_t config)
+        {
+            perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.type = type;
+            attributes.config = config;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attributes.disabled = m_leader < 0 ? 1 : 0; // Members follow the leader, which starts disabled.
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+
+            const auto file = static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, m_leader, 0));
+            const auto error = errno;
+            if (file < 0 && m_error.empty())
+            {
+                m_error = std::string(get_perf_counter_name(counter)) + ": " + std::strerror(error);
+                if (error == EACCES || error == EPERM)
+                {
+                    m_error += " (see /proc/sys/kernel/perf_event_paranoid)";
+                }
+            }
+
+            m_files[static_cast<size_t>(counter)] = file;
+            if (file >= 0)
+            {
+                m_leader = m_leader < 0 ? file : m_leader;
+                m_group.push_back(static_cast<size_t>(counter));
+            }
+        }
+#endif
+
+        std::array<int, perf_counter_count> m_files = {};
+        int m_leader = -1; // First counter that opened, the others joined its group.
+        std::vector<size_t> m_group; // Counters in the order they joined the group.
+        std::string m_error;
+
+    };
+
+    // The counters only see the thread solving the part. Work it hands to the uncounted_workers other task scheduler threads
+    // is missing, and the output says so.
+    inline void print_perf_counters(std::ostream& output, const perf_counters& counters, const uint64_t iterations, const size_t uncounted_workers)
+    {
+        if (!counters.is_available())
+        {
+            output << "    perf counters unavailable: " << counters.get_error() << "\n";
+            return;
+        }
+
+        const auto values = counters.read().divided_by(iterations);
+        if (!values.any_available())
+        {
+            output << "    perf counters unavailable: the counter group was never scheduled\n";
+            return;
+        }
+
+        auto print_counter = [&](const char* label, const perf_counter counter)
+        {
+            output << "    " << label;
+            if (values.is_available(counter))
+            {
+                output << values.get(counter) << "\n";
+            }
+            else
+            {
+                output << "unavailable\n";
+            }
+        };
+
+        print_counter("cycles:        ", perf_counter::cycles);
+        print_counter("instructions:  ", perf_counter::instructions);
+        if (values.is_available(perf_counter::cycles) && values.is_available(perf_counter::instructions))
+        {
+            output << "    IPC:           " << values.get_instructions_per_cycle() << "\n";
+        }
+        print_counter("L1D misses:    ", perf_counter::l1d_read_misses);
+        print_counter("LLC misses:    ", perf_counter::llc_read_misses);
+        print_counter("branch misses: ", perf_counter::branch_misses);
+        if (values.is_multiplexed())
+        {
+            output << "    multiplexed:   counted " << values.get_running_fraction() * 100.0 << "% of the time, values scaled\n";
+        }
+        if (uncounted_workers != 0)
+        {
+            output << "    solving thread only, work of the " << uncounted_workers << " other --grid-threads workers is not counted\n";
+        }
+    }
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef AOC_UTILITY_PREFETCH_HPP
+#define AOC_UTILITY_PREFETCH_HPP
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+
+// Reads and parses inputs on a background thread while other threads solve the inputs before them.
+namespace aoc
+{
+
+    struct prefetch_statistics
+    {
+        size_t inputs = 0;
+        std::chrono::nanoseconds prepare_time = {}; // Spent reading and parsing on the background thread.
+        std::chrono::nanoseconds full_time = {}; // The background thread waited for room in the queue.
+        std::chrono::nanoseconds empty_time = {}; // Summed over all solving threads that waited for an input.
+    };
+
+    // Calls prepare(index) for every index in [0, count) in order on a background thread, and hands the results to take() in the same order.
+    // At most `capacity` prepared items wait in the queue; the background thread blocks while it is full,
+    // so the memory held by read inputs stays bounded when solving is slower than reading.
+    template<typename TItem>
+    class input_prefetcher
+    {
+
+    public:
+
+        template<typename TPrepare>
+        input_prefetcher(const size_t count, const size_t capacity, TPrepare prepare) :
+            m_count(count),
+            m_capacity(std::max(size_t{ 1 }, capacity))
+        {
+            m_thread = std::thread([this, prepare = std::move(prepare)]() mutable { run(prepare); });
+        }
+
+        ~input_prefetcher()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stopping = true;
+            }
+            m_condition.notify_all();
+            m_thread.join();
+        }
+
+        input_prefetcher(const input_prefetcher&) = delete;
+        input_prefetcher& operator = (const input_prefetcher&) = delete;
+
+        // Waits for the next prepared item. Returns false once every item was taken. Safe to call from several threads.
+        bool take(size_t& index, TItem& item)
+        {
+            const auto start_time = std::chrono::high_resolution_clock::now();
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this]() { return !m_queue.empty() || m_taken == m_count; });
+                if (m_queue.empty())
+                {
+                    return false;
+                }
+
+                index = m_taken++;
+                item = std::move(m_queue.front());
+                m_queue.pop_front();
+                m_statistics.empty_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_time);
+            }
+            m_condition.notify_all();
+            return true;
+        }
+
+        prefetch_statistics get_statistics() const
+        {
+            std::lock_guard lock(m_mutex);
+            return m_statistics;
+        }
+
+    private:
+
+        template<typename TPrepare>
+        void run(TPrepare& prepare)
+        {
+            for (size_t i = 0; i < m_count; i++)
+            {
+                const auto start_time = std::chrono::high_resolution_clock::now();
+                auto item = prepare(i);
+                const auto prepared_time = std::chrono::high_resolution_clock::now();
+
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stopping || m_queue.size() < m_capacity; });
+                    if (m_stopping)
+                    {
+                        return;
+                    }
+
+                    m_queue.push_back(std::move(item));
+                    ++m_statistics.inputs;
+                    m_statistics.prepare_time += std::chrono::duration_cast<std::chrono::nanoseconds>(prepared_time - start_time);
+                    m_statistics.full_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - prepared_time);
+                }
+                m_condition.notify_all();
+            }
+        }
+
+        const size_t m_count;
+        const size_t m_capacity;
+        size_t m_taken = 0;
+        bool m_stopping = false;
+        std::deque<TItem> m_queue;
+        prefetch_statistics m_statistics;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::thread m_thread;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef AOC_UTILITY_PROFILER_HPP
+#define AOC_UTILITY_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <set>
+#include <mutex>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <filesystem>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include "options.hpp"
+
+#if defined(AOC_ENABLE_PROFILER) && defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#include <csignal>
+#include <ctime>
+#include <pthread.h>
+#include <ucontext.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#define AOC_PROFILER_SUPPORTED
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid // glibc before 2.41 only defines the kernel name.
+#endif
+#endif
+
+// Sampling profiler of single parts, enabled with --profile in builds with the AOC_ENABLE_PROFILER CMake option.
+// A timer on the CPU time of the thread solving a part raises SIGPROF, and the signal handler walks the frame pointers of the
+// interrupted code into a ring buffer. After the part the samples are symbolized and written as collapsed stacks,
+// the input format of flamegraph.pl and speedscope.
+namespace aoc
+{
+
+    inline constexpr size_t profile_max_depth = 64;
+    inline constexpr size_t profile_ring_capacity = 16384; // Samples, 16 seconds of CPU time at the default frequency.
+
+    struct profile_sample
+    {
+        uint32_t depth = 0;
+        std::array<uintptr_t, profile_max_depth> frames; // Code addresses, innermost first.
+    };
+
+    // Samples written by the signal handler of one thread and read by the same thread once sampling stopped.
+    // Writing only touches preallocated slots and lock-free atomics, which is safe inside a signal handler.
+    class profile_ring
+    {
+
+    public:
+
+        static_assert(std::atomic<size_t>::is_always_lock_free);
+
+        profile_ring() :
+            m_samples(std::make_unique<profile_sample[]>(profile_ring_capacity))
+        {}
+
+        // Slot of the next sample, or nullptr if the ring is full and the sample is dropped.
+        profile_sample* begin_write()
+        {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) >= profile_ring_capacity)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            return &m_samples[head % profile_ring_capacity];
+        }
+
+        void end_write()
+        {
+            m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+        // Calls callback(sample) for every written sample and frees their slots.
+        template<typename TCallback>
+        void drain(TCallback&& callback)
+        {
+            const auto head = m_head.load(std::memory_order_acquire);
+            auto tail = m_tail.load(std::memory_order_relaxed);
+            for (; tail != head; tail++)
+            {
+                callback(m_samples[tail % profile_ring_capacity]);
+            }
+            m_tail.store(tail, std::memory_order_release);
+        }
+
+        size_t get_dropped() const
+        {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        // Stack of the sampled thread. A frame pointer outside of it ends the walk of a sample.
+        uintptr_t stack_begin = 0;
+        uintptr_t stack_end = 0;
+
+    private:
+
+        std::unique_ptr<profile_sample[]> m_samples;
+        std::atomic<size_t> m_head = 0;
+        std::atomic<size_t> m_tail = 0;
+        std::atomic<size_t> m_dropped = 0;
+
+    };
+
+    namespace detail
+    {
+
+        inline std::mutex& get_profile_file_mutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        // Appends collapsed stacks to a file. The first write of a process truncates it, so the profiles of every input of a batch add up.
+        inline bool write_profile_stacks(const std::string& filename, const std::map<std::string, size_t>& stacks)
+        {
+            static std::set<std::string> written_files;
+            std::lock_guard lock(get_profile_file_mutex());
+
+            const auto is_first_write = written_files.insert(filename).second;
+            std::ofstream file(filename, is_first_write ? std::ios::trunc : std::ios::app);
+            for (const auto& [stack, count] : stacks)
+            {
+                file << stack << " " << count << "\n";
+            }
+            return file.good();
+        }
+
+#if defined(AOC_PROFILER_SUPPORTED)
+
+        inline profile_ring*& get_thread_profile_ring()
+        {
+            thread_local profile_ring* ring = nullptr;
+            return ring;
+        }
+
+        inline void handle_profile_signal(int, siginfo_t*, void* context)
+        {
+            auto* ring = get_thread_profile_ring();
+            if (ring == nullptr)
+            {
+                return;
+            }
+            auto* sample = ring->begin_write();
+            if (sample == nullptr)
+            {
+                return;
+            }
+
+            const auto& machine = static_cast<const ucontext_t*>(context)->uc_mcontext;
+#if defined(__x86_64__)
+            const auto pc = static_cast<uintptr_t>(machine.gregs[REG_RIP]);
+            auto frame = static_cast<uintptr_t>(machine.gregs[REG_RBP]);
+#else
+            const auto pc = static_cast<uintptr_t>(machine.pc);
+            auto frame = static_cast<uintptr_t>(machine.regs[29]);
+#endif
+
+            // Every frame starts with the frame pointer of its caller, followed by the return address into the caller.
+            uint32_t depth = 0;
+            sample->frames[depth++] = pc;
+            while (depth < profile_max_depth && frame % sizeof(uintptr_t) == 0 &&
+                frame >= ring->stack_begin && frame + 2 * sizeof(uintptr_t) <= ring->stack_end)
+            {
+                const auto* words = reinterpret_cast<const uintptr_t*>(frame);
+                if (words[1] == 0)
+                {
+                    break;
+                }
+                sample->frames[depth++] = words[1] - 1; // Inside the call instruction, so it symbolizes to the calling function.
+                if (words[0] <= frame)
+                {
+                    break;
+                }
+                frame = words[0];
+            }
+
+            sample->depth = depth;
+            ring->end_write();
+        }
+
+        inline bool install_profile_signal_handler()
+        {
+            static const bool installed = []()
+            {
+                struct sigaction action = {};
+                action.sa_sigaction = handle_profile_signal;
+                action.sa_flags = SA_SIGINFO | SA_RESTART;
+                sigemptyset(&action.sa_mask);
+                return sigaction(SIGPROF, &action, nullptr) == 0;
+            }();
+            return installed;
+        }
+
+        // Demangled name of the function holding a code address, or module+offset if the executable does not export its symbol.
+        inline std::string symbolize_address(const uintptr_t address)
+        {
+            std::ostringstream name;
+            Dl_info info = {};
+            if (dladdr(reinterpret_cast<void*>(address), &info) == 0)
+            {
+                name << "0x" << std::hex << address;
+            }
+            else if (info.dli_sname != nullptr)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                name << (status == 0 && demangled != nullptr ? demangled : info.dli_sname);
+                std::free(demangled);
+            }
+            else
+            {
+                const auto module = info.dli_fname != nullptr ? std::filesystem::path(info.dli_fname).filename().string() : std::string("?");
+                name << module << "+0x" << std::hex << (address - reinterpret_cast<uintptr_t>(info.dli_fbase));
+            }
+
+            // Semicolons separate frames and a trailing number is the count of a collapsed stack.
+            auto result = name.str();
+            for (auto& c : result)
+            {
+                c = c == ';' ? ':' : c;
+            }
+            return result;
+        }
+
+#endif
+
+    }
+
+    inline bool is_profiler_supported()
+    {
+#if defined(AOC_PROFILER_SUPPORTED)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Samples the calling thread while it solves one part of a day, if --profile is set. Only this thread is sampled,
+    // work a part hands to the task scheduler or parallel grid loops on other threads is missing from its profile.
+    class part_profiler
+    {
+
+    public:
+
+        part_profiler(const size_t day, const size_t part) :
+            m_day(day),
+            m_part(part)
+        {
+#if defined(AOC_PROFILER_SUPPORTED)
+            const auto& options = get_options();
+            if (options.profile_directory.empty() || !detail::install_profile_signal_handler())
+            {
+                return;
+            }
+
+            m_ring = std::make_unique<profile_ring>();
+            pthread_attr_t attributes;
+            if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+            {
+                void* stack = nullptr;
+                size_t stack_size = 0;
+                if (pthread_attr_getstack(&attributes, &stack, &stack_size) == 0)
+                {
+                    m_ring->stack_begin = reinterpret_cast<uintptr_t>(stack);
+                    m_ring->stack_end = m_ring->stack_begin + stack_size;
+                }
+                pthread_attr_destroy(&attributes);
+            }
+
+            detail::get_thread_profile_ring() = m_ring.get();
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+
+            sigevent event = {};
+            event.sigev_notify = SIGEV_THREAD_ID;
+            event.sigev_signo = SIGPROF;
+            event.sigev_notify_thread_id = static_cast<pid_t>(::syscall(SYS_gettid));
+            if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &m_timer) != 0)
+            {
+                detail::get_thread_profile_ring() = nullptr;
+                m_ring.reset();
+                return;
+            }
+
+            const auto interval = 1000000000ll / static_cast<long long>(std::max(options.profile_frequency, size_t{ 1 }));
+            itimerspec specification = {};
+            specification.it_interval.tv_sec = static_cast<time_t>(interval / 1000000000ll);
+            specification.it_interval.tv_nsec = static_cast<long>(interval % 1000000000ll);
+            specification.it_value = specification.it_interval;
+            timer_settime(m_timer, 0, &specification, nullptr);
+#endif
+        }
+
+        ~part_profiler()
+        {
+            stop();
+        }
+
+        part_profiler(const part_profiler&) = delete;
+        part_profiler& operator = (const part_profiler&) = delete;
+
+        // Stops sampling and writes the collapsed stacks to <profile dir>/day_<N>_part_<P>.folded, with a summary line to output.
+        void finish(std::ostream& output)
+        {
+            if (!stop())
+            {
+                return;
+            }
+
+            std::unordered_map<uintptr_t, std::string> names;
+            std::map<std::string, size_t> stacks;
+            size_t sample_count = 0;
+#if defined(AOC_PROFILER_SUPPORTED)
+            m_ring->drain([&](const profile_sample& sample)
+            {
+                std::string stack;
+                for (auto i = sample.depth; i-- > 0;)
+                {
+                    auto name = names.find(sample.frames[i]);
+                    if (name == names.end())
+                    {
+                        name = names.emplace(sample.frames[i], detail::symbolize_address(sample.frames[i])).first;
+                    }
+                    stack += name->second;
+                    stack += i != 0 ? ";" : "";
+                }
+                ++stacks[stack];
+                ++sample_count;
+            });
+#endif
+
+            const auto& directory = get_options().profile_directory;
+            const auto filename = (std::filesystem::path(directory) / ("day_" + std::to_string(m_day) + "_part_" + std::to_string(m_part) + ".folded")).string();
+            std::error_code error;
+            std::filesystem::create_directories(directory, error);
+            if (!detail::write_profile_stacks(filename, stacks))
+            {
+                output << "    profile: Failed to write file: " << filename << "\n";
+                return;
+            }
+            output << "    profile: " << sample_count << " samples, " << m_ring->get_dropped() << " dropped, written to " << filename << "\n";
+        }
+
+    private:
+
+        // Returns true if the part was being sampled.
+        bool stop()
+        {
+#if defined(AOC_PROFILER_SUPPORTED)
+            if (m_ring && !m_stopped)
+            {
+                timer_delete(m_timer);
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                detail::get_thread_profile_ring() = nullptr;
+                m_stopped = true;
+                return true;
+            }
+#endif
+            return false;
+        }
+
+        size_t m_day = 0;
+        size_t m_part = 0;
+        std::unique_ptr<profile_ring> m_ring;
+        bool m_stopped = false;
+#if defined(AOC_PROFILER_SUPPORTED)
+        timer_t m_timer = {};
+#endif
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef AOC_UTILITY_REPORT_HPP
+#define AOC_UTILITY_REPORT_HPP
+
+#include "benchmark.hpp"
+#include "perf_counters.hpp"
+#include "allocations.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <optional>
+#include <charconv>
+
+namespace aoc
+{
+
+    struct part_report
+    {
+        size_t part = 0;
+        std::string result;
+        timing_statistics timing;
+        std::optional<perf_counter_values> counters; // Average per iteration, if counted.
+        std::optional<allocation_statistics> allocations; // Average per iteration, if built with AOC_TRACK_ALLOCATIONS.
+    };
+
+    struct puzzle_report
+    {
+        size_t day = 0;
+        std::chrono::nanoseconds read_time = {};
+        std::optional<std::chrono::nanoseconds> parse_time;
+        std::vector<part_report> parts;
+    };
+
+    // Median time in nanoseconds per stage name ("read", "parse", "part_1", ...), keyed by day.
+    using baseline_timings = std::map<std::pair<size_t, std::string>, int64_t>;
+
+    inline timing_statistics make_single_timing(const std::chrono::nanoseconds duration)
+    {
+        return { 1, duration, duration, duration, duration, duration, std::chrono::nanoseconds{ 0 } };
+    }
+
+    inline std::string get_part_stage_name(const size_t part)
+    {
+        return "part_" + std::to_string(part);
+    }
+
+    inline std::string escape_json_string(std::string_view value)
+    {
+        std::string result;
+        result.reserve(value.size());
+        for (const auto c : value)
+        {
+            switch (c)
+            {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default: result += c; break;
+            }
+        }
+        return result;
+    }
+
+    inline void write_timing_json(std::ostream& stream, const timing_statistics& timing)
+    {
+        stream <<
+            "\"iterations\": " << timing.iterations <<
+            ", \"min_ns\": " << timing.min.count() <<
+            ", \"median_ns\": " << timing.median.count() <<
+            ", \"mean_ns\": " << timing.mean.count() <<
+            ", \"p90_ns\": " << timing.p90.count() <<
+            ", \"p99_ns\": " << timing.p99.count() <<
+            ", \"stddev_ns\": " << timing.standard_deviation.count();
+    }
+
+    inline void write_counters_json(std::ostream& stream, const perf_counter_values& counters)
+    {
+        stream << ", \"counters\": { ";
+        bool first = true;
+        for (size_t i = 0; i < perf_counter_count; i++)
+        {
+            const auto counter = static_cast<perf_counter>(i);
+            if (counters.is_available(counter))
+            {
+                stream << (first ? "" : ", ") << "\"" << get_perf_counter_name(counter) << "\": " << counters.get(counter);
+                first = false;
+            }
+        }
+        if (counters.is_multiplexed())
+        {
+            stream << (first ? "" : ", ") << "\"running_fraction\": " << counters.get_running_fraction();
+            first = false;
+        }
+        if (counters.uncounted_workers != 0)
+        {
+            stream << (first ? "" : ", ") << "\"uncounted_workers\": " << counters.uncounted_workers;
+        }
+        stream << " }";
+    }
+
+    inline void write_allocations_json(std::ostream& stream, const allocation_statistics& allocations)
+    {
+        stream << ", \"allocations\": { \"count\": " << allocations.count <<
+            ", \"bytes\": " << allocations.bytes <<
+            ", \"peak_bytes\": " << allocations.peak_bytes << " }";
+    }
+
+    inline void write_report_json(std::ostream& stream, const puzzle_report& report)
+    {
+        stream << "    {\n";
+        stream << "      \"day\": " << report.day << ",\n";
+        stream << "      \"read\": { ";
+        write_timing_json(stream, make_single_timing(report.read_time));
+        stream << " },\n";
+        if (report.parse_time)
+        {
+            stream << "      \"parse\": { ";
+            write_timing_json(stream, make_single_timing(*report.parse_time));
+            stream << " },\n";
+        }
+        stream << "      \"parts\": [";
+        for (size_t i = 0; i < report.parts.size(); i++)
+        {
+            const auto& part = report.parts[i];
+            stream << (i == 0 ? "\n" : ",\n");
+            stream << "        { \"part\": " << part.part << ", \"result\": \"" << escape_json_string(part.result) << "\", ";
+            write_timing_json(stream, part.timing);
+            if (part.counters && part.counters->any_available())
+            {
+                write_counters_json(stream, *part.counters);
+            }
+            if (part.allocations)
+            {
+                write_allocations_json(stream, *part.allocations);
+            }
+            stream << " }";
+        }
+        stream << "\n      ]\n";
+        stream << "    }";
+    }
+
+    inline void write_reports_json(std::ostream& stream, const std::vector<puzzle_report>& reports)
+    {
+        stream << "{\n";
+        stream << "  \"days\": [";
+        for (size_t i = 0; i < reports.size(); i++)
+        {
+            stream << (i == 0 ? "\n" : ",\n");
+            write_report_json(stream, reports[i]);
+        }
+        stream << "\n  ]\n";
+        stream << "}\n";
+    }
+
+    inline void write_timing_csv(std::ostream& stream, const size_t day, const std::string& stage, const timing_statistics& timing)
+    {
+        stream << day << "," << stage << "," << timing.iterations << "," <<
+            timing.min.count() << "," << timing.median.count() << "," << timing.mean.count() << "," <<
+            timing.p90.count() << "," << timing.p99.count() << "," << timing.standard_deviation.count() << "\n";
+    }
+
+    inline void write_report_csv(std::ostream& stream, const puzzle_report& report)
+    {
+        write_timing_csv(stream, report.day, "read", make_single_timing(report.read_time));
+        if (report.parse_time)
+        {
+            write_timing_csv(stream, report.day, "parse", make_single_timing(*report.parse_time));
+        }
+        for (const auto& part : report.parts)
+        {
+            write_timing_csv(stream, report.day, get_part_stage_name(part.part), part.timing);
+        }
+    }
+
+    inline void write_reports_csv(std::ostream& stream, const std::vector<puzzle_report>& reports)
+    {
+        stream << "day,stage,iterations,min_ns,median_ns,mean_ns,p90_ns,p99_ns,stddev_ns\n";
+        for (const auto& report : reports)
+        {
+            write_report_csv(stream, report);
+        }
+    }
+
+    inline bool ends_with(std::string_view value, std::string_view suffix)
+    {
+        return value.size() >= suffix.size() && value.substr(value.size() - suffix.size()) == suffix;
+    }
+
+    // Writes the reports as JSON or CSV, depending on the file extension.
+    inline bool write_report(const std::string& filename, const std::vector<puzzle_report>& reports)
+    {
+        const bool is_json = ends_with(filename, ".json");
+        if (!is_json && !ends_with(filename, ".csv"))
+        {
+            std::cerr << "write_report: Unknown report format, expecting .json or .csv: " << filename << "\n";
+            return false;
+        }
+
+        std::ofstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "write_report: Failed to open report file: " << filename << "\n";
+            return false;
+        }
+
+        if (is_json)
+        {
+            write_reports_json(file, reports);
+        }
+        else
+        {
+            write_reports_csv(file, reports);
+        }
+
+        return file.good();
+    }
+
+    // Parses a whole CSV column as a number. Returns false on anything else, including an empty column or trailing characters.
+    template<typename T>
+    bool parse_csv_number(const std::string_view column, T& value)
+    {
+        const auto result = std::from_chars(column.data(), column.data() + column.size(), value);
+        return result.ec == std::errc() && result.ptr == column.data() + column.size();
+    }
+
+    // Reads median timings from a CSV report, as written by write_reports_csv.
+    inline bool read_baseline(const std::string& filename, baseline_timings& baseline)
+    {
+        if (!ends_with(filename, ".csv"))
+        {
+            std::cerr << "read_baseline: Baseline must be a CSV report: " << filename << "\n";
+            return false;
+        }
+
+        std::ifstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "read_baseline: Failed to open baseline file: " << filename << "\n";
+            return false;
+        }
+
+        std::string line;
+        std::getline(file, line); // Header.
+
+        while (std::getline(file, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+
+            std::vector<std::string> columns;
+            std::stringstream ss(line);
+            std::string column;
+            while (std::getline(ss, column, ','))
+            {
+                columns.push_back(column);
+            }
+
+            size_t day = 0;
+            int64_t median = 0;
+            if (columns.size() != 9 || !parse_csv_number(columns[0], day) || !parse_csv_number(columns[4], median))
+            {
+                std::cerr << "read_baseline: Invalid baseline row: " << line << "\n";
+                return false;
+            }
+
+            baseline[{ day, columns[1] }] = median;
+        }
+
+        return true;
+    }
+
+    // Prints every stage compared to the baseline. Returns false if any gated stage is slower than the threshold allows.
+    // Stages timed once, read and parse, vary too much between runs to gate on; they are printed but never fail the comparison.
+    // parse_options only accepts --baseline with several --benchmark iterations, so the parts are always gated.
+    inline bool compare_to_baseline(const puzzle_report& report, const baseline_timings& baseline, const double threshold_percent)
+    {
+        bool passed = true;
+
+        auto compare_stage = [&](const std::string& stage, const std::chrono::nanoseconds median, const bool gated)
+        {
+            const auto it = baseline.find({ report.day, stage });
+            if (it == baseline.end())
+            {
+                std::cout << "Baseline " << stage << ": missing, skipped\n";
+                return;
+            }
+
+            const auto baseline_median = static_cast<double>(it->second);
+            const auto current_median = static_cast<double>(median.count());
+            const auto change_percent = baseline_median > 0.0 ? ((current_median - baseline_median) / baseline_median) * 100.0 : 0.0;
+            const bool regressed = gated && change_percent > threshold_percent;
+
+            std::cout << "Baseline " << stage << ": " << (change_percent >= 0.0 ? "+" : "") << change_percent << "%" <<
+                (regressed ? "    REGRESSION" : "") << (gated ? "" : "    (single sample, not gated)") << "\n";
+
+            if (regressed)
+            {
+                passed = false;
+            }
+        };
+
+        compare_stage("read", report.read_time, false);
+        if (report.parse_time)
+        {
+            compare_stage("parse", *report.parse_time, false);
+        }
+        for (const auto& part : report.parts)
+        {
+            compare_stage(get_part_stage_name(part.part), part.timing.median, part.timing.iterations > 1);
+        }
+
+        return passed;
+    }
+
+}
+
+#endif
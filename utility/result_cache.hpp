@@ -0,0 +1,219 @@
+#ifndef AOC_UTILITY_RESULT_CACHE_HPP
+#define AOC_UTILITY_RESULT_CACHE_HPP
+
+#include "report.hpp"
+#include "mapped_file.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <functional>
+
+// On-disk cache of part results, keyed by a hash of the input file and the solver version.
+// Every entry is a small text file in the cache directory, holding the printed output and the timings of every part.
+namespace aoc
+{
+
+    inline constexpr std::string_view result_cache_magic = "aoc-result-cache 1";
+
+    // 64-bit FNV-1a over 8-byte words, then the remaining bytes. Not meant to resist crafted collisions.
+    inline uint64_t hash_bytes(const std::string_view bytes, uint64_t hash = 0xcbf29ce484222325ull)
+    {
+        constexpr uint64_t prime = 0x100000001b3ull;
+
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= bytes.size(); i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            hash = (hash ^ word) * prime;
+            hash ^= hash >> 29;
+        }
+        for (; i < bytes.size(); i++)
+        {
+            hash = (hash ^ static_cast<uint8_t>(bytes[i])) * prime;
+        }
+        return hash;
+    }
+
+    struct result_cache_key
+    {
+        size_t day = 0;
+        std::string version; // Changes whenever the solver is rebuilt.
+        uint64_t input_hash = 0;
+        uint64_t input_size = 0;
+
+        std::string get_filename(const std::string& directory) const
+        {
+            std::stringstream name;
+            name << "day_" << day << "_" << std::hex << std::setw(16) << std::setfill('0') << hash_bytes(version, input_hash) << ".txt";
+            return (std::filesystem::path(directory) / name.str()).string();
+        }
+    };
+
+    struct cached_part
+    {
+        std::string text; // Output printed by the part.
+        part_report report;
+    };
+
+    // Hashes the input file. Returns false if it cannot be read, the cache is not used then.
+    inline bool make_result_cache_key(const size_t day, const std::string& version, const std::string& input_filename, result_cache_key& key)
+    {
+        mapped_file file;
+        if (!file.open(input_filename))
+        {
+            return false;
+        }
+
+        const auto bytes = file.view();
+        key = { day, version, hash_bytes(bytes), bytes.size() };
+        return true;
+    }
+
+    namespace detail
+    {
+
+        inline void write_cached_string(std::ostream& stream, const std::string_view name, const std::string_view value)
+        {
+            stream << name << " " << value.size() << "\n" << value << "\n";
+        }
+
+        inline bool read_cached_string(std::istream& stream, const std::string_view name, std::string& value)
+        {
+            std::string read_name;
+            size_t size = 0;
+            if (!(stream >> read_name >> size) || read_name != name || stream.get() != '\n')
+            {
+                return false;
+            }
+
+            value.resize(size);
+            stream.read(value.data(), static_cast<std::streamsize>(size));
+            return stream.good() && stream.get() == '\n';
+        }
+
+        inline void write_cached_timing(std::ostream& stream, const timing_statistics& timing)
+        {
+            stream << "timing " << timing.iterations << " " << timing.min.count() << " " << timing.median.count() << " " <<
+                timing.mean.count() << " " << timing.p90.count() << " " << timing.p99.count() << " " << timing.standard_deviation.count() << "\n";
+        }
+
+        inline bool read_cached_timing(std::istream& stream, timing_statistics& timing)
+        {
+            std::string name;
+            int64_t min = 0, median = 0, mean = 0, p90 = 0, p99 = 0, standard_deviation = 0;
+            if (!(stream >> name >> timing.iterations >> min >> median >> mean >> p90 >> p99 >> standard_deviation) || name != "timing")
+            {
+                return false;
+            }
+
+            timing.min = std::chrono::nanoseconds{ min };
+            timing.median = std::chrono::nanoseconds{ median };
+            timing.mean = std::chrono::nanoseconds{ mean };
+            timing.p90 = std::chrono::nanoseconds{ p90 };
+            timing.p99 = std::chrono::nanoseconds{ p99 };
+            timing.standard_deviation = std::chrono::nanoseconds{ standard_deviation };
+            return true;
+        }
+
+    }
+
+    // Reads the entry of `key`. Returns false on a miss, including entries of another version or input.
+    inline bool read_result_cache(const std::string& directory, const result_cache_key& key, std::vector<cached_part>& parts)
+    {
+        std::ifstream file(key.get_filename(directory), std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        std::string magic;
+        std::string version;
+        size_t day = 0;
+        uint64_t input_hash = 0;
+        uint64_t input_size = 0;
+        size_t part_count = 0;
+        std::string name;
+
+        if (!std::getline(file, magic) || magic != result_cache_magic ||
+            !detail::read_cached_string(file, "version", version) || version != key.version ||
+            !(file >> name >> day >> std::hex >> input_hash >> std::dec >> input_size) || name != "input" ||
+            day != key.day || input_hash != key.input_hash || input_size != key.input_size ||
+            !(file >> name >> part_count) || name != "parts" || file.get() != '\n')
+        {
+            return false;
+        }
+
+        parts.clear();
+        for (size_t i = 0; i < part_count; i++)
+        {
+            cached_part part;
+            if (!(file >> name >> part.report.part) || name != "part" ||
+                !detail::read_cached_timing(file, part.report.timing) || file.get() != '\n' ||
+                !detail::read_cached_string(file, "result", part.report.result) ||
+                !detail::read_cached_string(file, "text", part.text))
+            {
+                return false;
+            }
+            parts.push_back(std::move(part));
+        }
+
+        return true;
+    }
+
+    // Writes the entry of `key`, replacing the file atomically so concurrent runs never read half an entry.
+    inline bool write_result_cache(const std::string& directory, const result_cache_key& key, const std::vector<cached_part>& parts)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+
+        const auto filename = key.get_filename(directory);
+        const auto unique_suffix = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        const auto temporary_filename = filename + ".tmp" + std::to_string(unique_suffix);
+        {
+            std::ofstream file(temporary_filename, std::ios::binary);
+            if (!file.is_open())
+            {
+                std::cerr << "write_result_cache: Failed to open file: " << temporary_filename << "\n";
+                return false;
+            }
+
+            file << result_cache_magic << "\n";
+            detail::write_cached_string(file, "version", key.version);
+            file << "input " << key.day << " " << std::hex << key.input_hash << std::dec << " " << key.input_size << "\n";
+            file << "parts " << parts.size() << "\n";
+            for (const auto& part : parts)
+            {
+                file << "part " << part.report.part << " ";
+                detail::write_cached_timing(file, part.report.timing);
+                detail::write_cached_string(file, "result", part.report.result);
+                detail::write_cached_string(file, "text", part.text);
+            }
+
+            if (!file.good())
+            {
+                std::cerr << "write_result_cache: Failed to write file: " << temporary_filename << "\n";
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary_filename, filename, error);
+        if (error)
+        {
+            std::cerr << "write_result_cache: Failed to replace file: " << filename << "\n";
+            std::filesystem::remove(temporary_filename, error);
+            return false;
+        }
+        return true;
+    }
+
+}
+
+#endif
@@ -0,0 +1,333 @@
+#ifndef AOC_UTILITY_TASK_SCHEDULER_HPP
+#define AOC_UTILITY_TASK_SCHEDULER_HPP
+
+#include "thread_pool.hpp"
+#include "options.hpp"
+#include "arena.hpp"
+#include "allocations.hpp"
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+// Work-stealing fork-join scheduler. Every worker owns a deque: it pushes and pops its own tasks at the back,
+// idle workers steal from the front of the others. Threads that are not workers, like the main thread, share one extra deque.
+// Waiting in task_group::sync() runs pending tasks instead of blocking, so tasks can spawn and sync recursively.
+namespace aoc
+{
+
+    class task_scheduler;
+
+    // Tasks spawned together, waited for with sync(). The first exception thrown by a task is rethrown by sync().
+    class task_group
+    {
+
+    public:
+
+        explicit task_group(task_scheduler& scheduler) :
+            m_scheduler(scheduler)
+        {}
+
+        ~task_group()
+        {
+            if (m_pending != 0)
+            {
+                sync_without_rethrow();
+            }
+        }
+
+        task_group(const task_group&) = delete;
+        task_group& operator = (const task_group&) = delete;
+
+        template<typename TFunction>
+        void spawn(TFunction&& function);
+
+        void sync();
+
+    private:
+
+        friend class task_scheduler;
+
+        void sync_without_rethrow();
+
+        void finish_task(std::exception_ptr exception)
+        {
+            if (exception)
+            {
+                std::lock_guard lock(m_exception_mutex);
+                if (!m_exception)
+                {
+                    m_exception = exception;
+                }
+            }
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        task_scheduler& m_scheduler;
+        std::atomic<size_t> m_pending = 0;
+        std::mutex m_exception_mutex;
+        std::exception_ptr m_exception;
+
+    };
+
+    class task_scheduler
+    {
+
+    public:
+
+        // Total number of threads taking part, including the thread calling sync(). One thread runs every task in sync().
+        explicit task_scheduler(const size_t thread_count = get_default_worker_count()) :
+            m_queues(std::max(size_t{ 1 }, thread_count))
+        {
+            const auto worker_count = m_queues.size() - 1;
+            m_workers.reserve(worker_count);
+            for (size_t i = 0; i < worker_count; i++)
+            {
+                m_workers.emplace_back([this, i]() { work(i); });
+            }
+        }
+
+        ~task_scheduler()
+        {
+            {
+                std::lock_guard lock(m_sleep_mutex);
+                m_stopping = true;
+            }
+            m_sleep_condition.notify_all();
+
+            for (auto& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        task_scheduler(const task_scheduler&) = delete;
+        task_scheduler& operator = (const task_scheduler&) = delete;
+
+        size_t get_thread_count() const
+        {
+            return m_queues.size();
+        }
+
+    private:
+
+        friend class task_group;
+
+        struct task
+        {
+            std::function<void()> function;
+            task_group* group = nullptr;
+            task_allocation_counters* allocations = nullptr; // Of the part that spawned the task, see allocation_tracker.
+        };
+
+        struct task_queue
+        {
+            std::mutex mutex;
+            std::deque<task> tasks;
+        };
+
+        struct worker_context
+        {
+            task_scheduler* scheduler = nullptr;
+            size_t index = 0;
+        };
+
+        static worker_context& get_worker_context()
+        {
+            thread_local worker_context context;
+            return context;
+        }
+
+        // Own deque of a worker, or the last, shared deque for every other thread.
+        size_t get_queue_index() const
+        {
+            const auto& context = get_worker_context();
+            return context.scheduler == this ? context.index : m_queues.size() - 1;
+        }
+
+        void push(task new_task)
+        {
+            auto& queue = m_queues[get_queue_index()];
+            {
+                std::lock_guard lock(queue.mutex);
+                queue.tasks.push_back(std::move(new_task));
+            }
+
+            m_queued.fetch_add(1, std::memory_order_seq_cst);
+            if (m_sleeping.load(std::memory_order_seq_cst) != 0)
+            {
+                std::lock_guard lock(m_sleep_mutex);
+                m_sleep_condition.notify_one();
+            }
+        }
+
+        // Pops the newest task of the own deque, or steals the oldest task of another one.
+        bool try_take(task& result)
+        {
+            const auto own_index = get_queue_index();
+            {
+                auto& queue = m_queues[own_index];
+                std::lock_guard lock(queue.mutex);
+                if (!queue.tasks.empty())
+                {
+                    result = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                    m_queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            for (size_t offset = 1; offset < m_queues.size(); offset++)
+            {
+                auto& queue = m_queues[(own_index + offset) % m_queues.size()];
+                std::lock_guard lock(queue.mutex);
+                if (!queue.tasks.empty())
+                {
+                    result = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    m_queued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Tasks allocate from the default resource, never from the part arena of the thread that happens to run them.
+        // Their allocations are counted for the part that spawned them.
+        static void run(task& current_task)
+        {
+            memory_resource_scope arena_scope(nullptr);
+            task_allocation_scope allocation_scope(current_task.allocations);
+            std::exception_ptr exception;
+            try
+            {
+                current_task.function();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+            current_task.group->finish_task(exception);
+        }
+
+        // Runs tasks until the group has none pending.
+        void help_until_done(task_group& group)
+        {
+            task current_task;
+            while (group.m_pending.load(std::memory_order_acquire) != 0)
+            {
+                if (try_take(current_task))
+                {
+                    run(current_task);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void work(const size_t index)
+        {
+            auto& context = get_worker_context();
+            context.scheduler = this;
+            context.index = index;
+
+            task current_task;
+            while (true)
+            {
+                if (try_take(current_task))
+                {
+                    run(current_task);
+                    continue;
+                }
+
+                std::unique_lock lock(m_sleep_mutex);
+                m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+                m_sleep_condition.wait(lock, [this]() { return m_stopping || m_queued.load(std::memory_order_seq_cst) != 0; });
+                m_sleeping.fetch_sub(1, std::memory_order_seq_cst);
+                if (m_stopping)
+                {
+                    return;
+                }
+            }
+        }
+
+        std::vector<task_queue> m_queues;
+        std::vector<std::thread> m_workers;
+        std::atomic<size_t> m_queued = 0;
+        std::atomic<size_t> m_sleeping = 0;
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_sleep_condition;
+        bool m_stopping = false;
+
+    };
+
+    template<typename TFunction>
+    void task_group::spawn(TFunction&& function)
+    {
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        m_scheduler.push({ std::forward<TFunction>(function), this, get_allocation_counters().spawned_tasks });
+    }
+
+    inline void task_group::sync()
+    {
+        sync_without_rethrow();
+
+        std::exception_ptr exception;
+        {
+            std::lock_guard lock(m_exception_mutex);
+            std::swap(exception, m_exception);
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    inline void task_group::sync_without_rethrow()
+    {
+        m_scheduler.help_until_done(*this);
+    }
+
+    // Total number of threads of parallel work within a part, including the calling thread. Set with --grid-threads.
+    inline size_t get_parallel_thread_count()
+    {
+        const auto count = get_options().parallel_worker_count;
+        return count == 0 ? get_default_worker_count() : count;
+    }
+
+    // Scheduler shared by all solvers of the process, created on first use.
+    inline task_scheduler& get_task_scheduler()
+    {
+        static task_scheduler scheduler(get_parallel_thread_count());
+        return scheduler;
+    }
+
+    // Calls function(chunk_begin, chunk_end) for chunks of at most `grain` indices of [begin, end).
+    // The range is split in halves recursively, so idle workers steal large chunks first.
+    template<typename TFunction>
+    void parallel_for(task_scheduler& scheduler, const size_t begin, const size_t end, const size_t grain, const TFunction& function)
+    {
+        if (end - begin <= std::max(grain, size_t{ 1 }) || begin >= end)
+        {
+            if (begin < end)
+            {
+                function(begin, end);
+            }
+            return;
+        }
+
+        const auto middle = begin + (end - begin) / 2;
+        task_group group(scheduler);
+        group.spawn([&scheduler, middle, end, grain, &function]() { parallel_for(scheduler, middle, end, grain, function); });
+        parallel_for(scheduler, begin, middle, grain, function);
+        group.sync();
+    }
+
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef AOC_UTILITY_THREAD_POOL_HPP
+#define AOC_UTILITY_THREAD_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace aoc
+{
+
+    inline size_t get_default_worker_count()
+    {
+        return std::max(size_t{ 1 }, static_cast<size_t>(std::thread::hardware_concurrency()));
+    }
+
+    // Pins the calling thread to a single logical processor. Returns false if unsupported or failed.
+    inline bool pin_current_thread(const size_t processor)
+    {
+#if defined(_WIN32)
+        const auto mask = DWORD_PTR{ 1 } << (processor % (sizeof(DWORD_PTR) * 8));
+        return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(processor % CPU_SETSIZE, &cpu_set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    // Fixed set of workers executing tasks in FIFO order. The destructor finishes all queued tasks.
+    class thread_pool
+    {
+
+    public:
+
+        using task = std::function<void()>;
+
+        explicit thread_pool(const size_t worker_count = get_default_worker_count(), const bool pin_workers = false)
+        {
+            const auto processor_count = get_default_worker_count();
+            m_workers.reserve(std::max(size_t{ 1 }, worker_count));
+
+            for (size_t i = 0; i < std::max(size_t{ 1 }, worker_count); i++)
+            {
+                m_workers.emplace_back([this, i, pin_workers, processor_count]()
+                {
+                    if (pin_workers)
+                    {
+                        pin_current_thread(i % processor_count);
+                    }
+                    work();
+                });
+            }
+        }
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_stopping = true;
+            }
+            m_condition.notify_all();
+
+            for (auto& worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator = (const thread_pool&) = delete;
+
+        void push(task new_task)
+        {
+            {
+                std::lock_guard lock(m_mutex);
+                m_tasks.push_back(std::move(new_task));
+            }
+            m_condition.notify_one();
+        }
+
+        size_t get_worker_count() const
+        {
+            return m_workers.size();
+        }
+
+    private:
+
+        void work()
+        {
+            while (true)
+            {
+                task next_task;
+                {
+                    std::unique_lock lock(m_mutex);
+                    m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+                    if (m_tasks.empty())
+                    {
+                        return;
+                    }
+
+                    next_task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+
+                next_task();
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+        std::deque<task> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopping = false;
+
+    };
+
+}
+
+#endif
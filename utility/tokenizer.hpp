@@ -0,0 +1,326 @@
+#ifndef AOC_UTILITY_TOKENIZER_HPP
+#define AOC_UTILITY_TOKENIZER_HPP
+
+#include <string_view>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define AOC_TOKENIZER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AOC_TOKENIZER_SSE2
+#endif
+
+// Vectorised scanning of input text. Text is classified 64 bytes at a time into bit masks, with AVX2 if the build enables it,
+// SSE2 on other x86-64 builds and a scalar loop elsewhere. Runs of digits are converted eight digits at a time with SWAR arithmetic.
+namespace aoc
+{
+
+    inline constexpr size_t tokenizer_block_size = 64;
+
+    // Instruction set used by the vectorised tokenizer functions.
+    inline constexpr std::string_view get_tokenizer_instruction_set()
+    {
+#if defined(AOC_TOKENIZER_AVX2)
+        return "AVX2";
+#elif defined(AOC_TOKENIZER_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+    namespace detail
+    {
+
+        // Bit i is set if block[i] equals `byte`. Reads exactly tokenizer_block_size bytes.
+        template<bool VVectorised = true>
+        uint64_t match_byte(const char* block, const char byte)
+        {
+#if defined(AOC_TOKENIZER_AVX2)
+            if constexpr (VVectorised)
+            {
+                const auto pattern = _mm256_set1_epi8(byte);
+                const auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+                const auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+                return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, pattern))) |
+                    (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, pattern)))) << 32);
+            }
+#elif defined(AOC_TOKENIZER_SSE2)
+            if constexpr (VVectorised)
+            {
+                const auto pattern = _mm_set1_epi8(byte);
+                uint64_t mask = 0;
+                for (size_t i = 0; i < tokenizer_block_size; i += 16)
+                {
+                    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+                    mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, pattern)))) << i;
+                }
+                return mask;
+            }
+#endif
+            uint64_t mask = 0;
+            for (size_t i = 0; i < tokenizer_block_size; i++)
+            {
+                mask |= static_cast<uint64_t>(block[i] == byte) << i;
+            }
+            return mask;
+        }
+
+        // Bit i is set if block[i] is a decimal digit. Reads exactly tokenizer_block_size bytes.
+        template<bool VVectorised = true>
+        uint64_t match_digits(const char* block)
+        {
+            // Signed comparisons, bytes of 0x80 and above are negative and never digits.
+#if defined(AOC_TOKENIZER_AVX2)
+            if constexpr (VVectorised)
+            {
+                const auto below = _mm256_set1_epi8('0' - 1);
+                const auto above = _mm256_set1_epi8('9' + 1);
+                auto digits = [&](const __m256i bytes)
+                {
+                    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpgt_epi8(bytes, below), _mm256_cmpgt_epi8(above, bytes))));
+                };
+                return digits(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block))) |
+                    (static_cast<uint64_t>(digits(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)))) << 32);
+            }
+#elif defined(AOC_TOKENIZER_SSE2)
+            if constexpr (VVectorised)
+            {
+                const auto below = _mm_set1_epi8('0' - 1);
+                const auto above = _mm_set1_epi8('9' + 1);
+                uint64_t mask = 0;
+                for (size_t i = 0; i < tokenizer_block_size; i += 16)
+                {
+                    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+                    const auto digits = _mm_and_si128(_mm_cmpgt_epi8(bytes, below), _mm_cmpgt_epi8(above, bytes));
+                    mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(digits))) << i;
+                }
+                return mask;
+            }
+#endif
+            uint64_t mask = 0;
+            for (size_t i = 0; i < tokenizer_block_size; i++)
+            {
+                mask |= static_cast<uint64_t>(static_cast<unsigned char>(block[i] - '0') < 10) << i;
+            }
+            return mask;
+        }
+
+        // Calls callback(block_offset, mask) for every block of text, where mask = match(block) holds one bit per byte of text.
+        // The last, partial block is copied into a zero padded buffer and its mask cut at the end of the text.
+        template<typename TMatch, typename TCallback>
+        void for_each_block_mask(const std::string_view text, TMatch&& match, TCallback&& callback)
+        {
+            size_t offset = 0;
+            for (; offset + tokenizer_block_size <= text.size(); offset += tokenizer_block_size)
+            {
+                callback(offset, match(text.data() + offset));
+            }
+
+            if (offset < text.size())
+            {
+                const auto size = text.size() - offset;
+                char block[tokenizer_block_size] = {};
+                std::memcpy(block, text.data() + offset, size);
+                callback(offset, match(block) & ((uint64_t{ 1 } << size) - 1));
+            }
+        }
+
+        inline constexpr uint64_t ascii_zeros = 0x3030303030303030ull;
+
+        // Loads `count` characters, one to eight, right aligned behind leading '0' characters. If the eight bytes ending at
+        // digits + count are readable, from `readable_begin` on, they are loaded as one word and the bytes before the digits masked.
+        inline uint64_t load_digits(const char* digits, const size_t count, const char* readable_begin)
+        {
+            const auto padding_bits = 8 * (sizeof(uint64_t) - count);
+            const auto padding_mask = (uint64_t{ 1 } << padding_bits) - 1;
+
+            if (digits + count >= readable_begin + sizeof(uint64_t))
+            {
+                uint64_t chunk;
+                std::memcpy(&chunk, digits + count - sizeof(chunk), sizeof(chunk));
+                return (chunk & ~padding_mask) | (ascii_zeros & padding_mask);
+            }
+
+            uint64_t chunk = ascii_zeros & padding_mask;
+            for (size_t i = 0; i < count; i++)
+            {
+                chunk |= static_cast<uint64_t>(static_cast<unsigned char>(digits[i])) << (padding_bits + 8 * i);
+            }
+            return chunk;
+        }
+
+        // True if all eight characters are decimal digits.
+        inline bool is_eight_digits(const uint64_t chunk)
+        {
+            return ((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+        }
+
+        // Value of eight digits loaded as a little-endian word, the first digit in the lowest byte.
+        inline uint64_t parse_eight_digits(uint64_t chunk)
+        {
+            constexpr uint64_t mask = 0x000000FF000000FFull;
+            constexpr uint64_t multiplier_1 = 100 + (1000000ull << 32);
+            constexpr uint64_t multiplier_2 = 1 + (10000ull << 32);
+
+            chunk -= ascii_zeros;
+            chunk = (chunk * 10) + (chunk >> 8);
+            return (((chunk & mask) * multiplier_1) + (((chunk >> 16) & mask) * multiplier_2)) >> 32;
+        }
+
+        // Value of a run of decimal digits. Returns false if it does not fit into 64 bits.
+        inline bool parse_digits(const char* digits, size_t count, const char* readable_begin, uint64_t& value)
+        {
+            while (count > 1 && *digits == '0')
+            {
+                ++digits;
+                --count;
+            }
+            if (count > std::numeric_limits<uint64_t>::digits10)
+            {
+                return false;
+            }
+
+            if constexpr (std::endian::native != std::endian::little)
+            {
+                value = 0;
+                for (size_t i = 0; i < count; i++)
+                {
+                    value = value * 10 + static_cast<uint64_t>(digits[i] - '0');
+                }
+                return true;
+            }
+
+            const auto head = count % 8;
+            value = head != 0 ? parse_eight_digits(load_digits(digits, head, readable_begin)) : 0;
+            for (size_t i = head; i < count; i += 8)
+            {
+                uint64_t chunk;
+                std::memcpy(&chunk, digits + i, sizeof(chunk));
+                value = value * 100000000ull + parse_eight_digits(chunk);
+            }
+            return true;
+        }
+
+        // Value of a digit run, negated if `negative`. Returns false if it does not fit into int64_t.
+        inline bool make_integer(const char* digits, const size_t count, const char* readable_begin, const bool negative, int64_t& value)
+        {
+            uint64_t magnitude = 0;
+            if (!parse_digits(digits, count, readable_begin, magnitude) ||
+                magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0))
+            {
+                return false;
+            }
+
+            value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+            return true;
+        }
+
+        template<bool VVectorised>
+        bool parse_integers(const std::string_view text, std::vector<int64_t>& values)
+        {
+            bool success = true;
+            size_t run_begin = 0;
+            uint64_t carry = 0; // Whether the last byte of the previous block was a digit.
+
+            auto finish_run = [&](const size_t run_end)
+            {
+                const auto negative = run_begin != 0 && text[run_begin - 1] == '-';
+                int64_t value = 0;
+                if (make_integer(text.data() + run_begin, run_end - run_begin, text.data(), negative, value))
+                {
+                    values.push_back(value);
+                }
+                else
+                {
+                    success = false;
+                }
+            };
+
+            for_each_block_mask(text, [](const char* block) { return match_digits<VVectorised>(block); }, [&](const size_t offset, const uint64_t digits)
+            {
+                // A run starts at a digit after a non-digit and ends at a non-digit after a digit.
+                const auto previous = (digits << 1) | carry;
+                auto edges = digits ^ previous;
+                while (edges != 0)
+                {
+                    const auto bit = std::countr_zero(edges);
+                    if ((digits >> bit) & 1)
+                    {
+                        run_begin = offset + bit;
+                    }
+                    else
+                    {
+                        finish_run(offset + bit);
+                    }
+                    edges &= edges - 1;
+                }
+                carry = digits >> 63;
+            });
+
+            // A run reaching the end of the text, which ends with a full block.
+            if (!text.empty() && (text.size() % tokenizer_block_size == 0 && carry != 0))
+            {
+                finish_run(text.size());
+            }
+            return success;
+        }
+
+    }
+
+    // Calls callback(position) for every occurrence of `byte` in text, in order.
+    template<typename TCallback>
+    void for_each_byte(const std::string_view text, const char byte, TCallback&& callback)
+    {
+        detail::for_each_block_mask(text, [byte](const char* block) { return detail::match_byte(block, byte); }, [&](const size_t offset, uint64_t mask)
+        {
+            while (mask != 0)
+            {
+                callback(offset + std::countr_zero(mask));
+                mask &= mask - 1;
+            }
+        });
+    }
+
+    // Parses a token that is exactly one decimal integer, optionally preceded by '-' or '+'. Returns false on anything else or on overflow.
+    inline bool parse_integer(std::string_view token, int64_t& value)
+    {
+        const auto negative = !token.empty() && token.front() == '-';
+        if (!token.empty() && (token.front() == '-' || token.front() == '+'))
+        {
+            token.remove_prefix(1);
+        }
+        if (token.empty())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < token.size(); i += 8)
+        {
+            const auto count = std::min(token.size() - i, size_t{ 8 });
+            if (!detail::is_eight_digits(detail::load_digits(token.data() + i, count, token.data())))
+            {
+                return false;
+            }
+        }
+        return detail::make_integer(token.data(), token.size(), token.data(), negative, value);
+    }
+
+    // Appends every integer of text to values. An integer is a run of decimal digits, negative if directly preceded by '-';
+    // any other character separates integers. Returns false if an integer does not fit into int64_t, it is skipped then.
+    inline bool parse_integers(const std::string_view text, std::vector<int64_t>& values)
+    {
+        return detail::parse_integers<true>(text, values);
+    }
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef AOC_UTILITY_TRACE_HPP
+#define AOC_UTILITY_TRACE_HPP
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+
+// AOC_TRACE_SCOPE("name") records the lifetime of the enclosing scope as a Chrome trace event.
+// Scopes compile to nothing unless AOC_ENABLE_TRACE is defined, see the AOC_ENABLE_TRACE CMake option.
+#if defined(AOC_ENABLE_TRACE)
+#define AOC_TRACE_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define AOC_TRACE_CONCAT(lhs, rhs) AOC_TRACE_CONCAT_IMPL(lhs, rhs)
+#define AOC_TRACE_SCOPE(name) const aoc::trace_scope AOC_TRACE_CONCAT(aoc_trace_scope_, __LINE__)(name)
+#else
+#define AOC_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace aoc
+{
+
+    struct trace_event
+    {
+        const char* name;
+        int64_t start; // Nanoseconds since the recorder was created.
+        int64_t duration;
+        uint32_t day;
+        uint32_t part;
+    };
+
+    // Events are recorded into one buffer per thread, so recording never takes a lock.
+    class trace_recorder
+    {
+
+    public:
+
+        struct thread_buffer
+        {
+            uint32_t thread_id = 0;
+            uint32_t day = 0;
+            uint32_t part = 0;
+            std::vector<trace_event> events;
+        };
+
+        static trace_recorder& get()
+        {
+            static trace_recorder instance;
+            return instance;
+        }
+
+        void enable()
+        {
+            m_enabled.store(true, std::memory_order_relaxed);
+        }
+
+        bool is_enabled() const
+        {
+            return m_enabled.load(std::memory_order_relaxed);
+        }
+
+        int64_t now() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start_time).count();
+        }
+
+        thread_buffer& get_thread_buffer()
+        {
+            thread_local thread_buffer* buffer = nullptr;
+            if (buffer == nullptr)
+            {
+                std::lock_guard lock(m_mutex);
+                m_buffers.push_back(std::make_unique<thread_buffer>());
+                buffer = m_buffers.back().get();
+                buffer->thread_id = static_cast<uint32_t>(m_buffers.size());
+            }
+            return *buffer;
+        }
+
+        // Day and part attached to every following event of the calling thread.
+        void set_context(const size_t day, const size_t part)
+        {
+            auto& buffer = get_thread_buffer();
+            buffer.day = static_cast<uint32_t>(day);
+            buffer.part = static_cast<uint32_t>(part);
+        }
+
+        void record(const char* name, const int64_t start, const int64_t end)
+        {
+            auto& buffer = get_thread_buffer();
+            buffer.events.push_back({ name, start, end - start, buffer.day, buffer.part });
+        }
+
+        // Writes all recorded events in the Chrome trace event format, readable by chrome://tracing and Perfetto.
+        // Must not be called while other threads are recording.
+        bool write(const std::string& filename) const
+        {
+            std::ofstream file(filename);
+            if (!file.is_open())
+            {
+                std::cerr << "trace_recorder: Failed to open trace file: " << filename << "\n";
+                return false;
+            }
+
+            file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            bool first = true;
+            std::lock_guard lock(m_mutex);
+            for (const auto& buffer : m_buffers)
+            {
+                for (const auto& event : buffer->events)
+                {
+                    file << (first ? "\n" : ",\n");
+                    file << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->thread_id <<
+                        ",\"ts\":" << to_microseconds(event.start) << ",\"dur\":" << to_microseconds(event.duration) <<
+                        ",\"args\":{\"day\":" << event.day << ",\"part\":" << event.part << "}}";
+                    first = false;
+                }
+            }
+
+            file << "\n]}\n";
+            return file.good();
+        }
+
+    private:
+
+        trace_recorder() :
+            m_start_time(std::chrono::steady_clock::now())
+        {}
+
+        static std::string to_microseconds(const int64_t nanoseconds)
+        {
+            auto result = std::to_string(nanoseconds / 1000) + ".";
+            const auto fraction = std::to_string(nanoseconds % 1000);
+            return result + std::string(3 - fraction.size(), '0') + fraction;
+        }
+
+        std::atomic<bool> m_enabled = false;
+        std::chrono::steady_clock::time_point m_start_time;
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<thread_buffer>> m_buffers;
+
+    };
+
+    class trace_scope
+    {
+
+    public:
+
+        explicit trace_scope(const char* name) :
+            m_name(name),
+            m_start(trace_recorder::get().is_enabled() ? trace_recorder::get().now() : -1)
+        {}
+
+        ~trace_scope()
+        {
+            if (m_start >= 0)
+            {
+                auto& recorder = trace_recorder::get();
+                recorder.record(m_name, m_start, recorder.now());
+            }
+        }
+
+        trace_scope(const trace_scope&) = delete;
+        trace_scope& operator = (const trace_scope&) = delete;
+
+    private:
+
+        const char* m_name;
+        int64_t m_start;
+
+    };
+
+    inline void set_trace_context(const size_t day, const size_t part)
+    {
+#if defined(AOC_ENABLE_TRACE)
+        if (trace_recorder::get().is_enabled())
+        {
+            trace_recorder::get().set_context(day, part);
+        }
+#else
+        static_cast<void>(day);
+        static_cast<void>(part);
+#endif
+    }
+
+}
+
+#endif
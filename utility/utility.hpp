@@ -2,6 +2,7 @@
 #define AOC_UTILITY_UTILITY_HPP
 
 #include <exception>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -9,18 +10,53 @@
 #include <chrono>
 #include <type_traits>
 #include <charconv>
+#include <string_view>
+#include <memory>
+#include <sstream>
+#include <cstdlib>
+#include <functional>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <span>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+#include "mapped_file.hpp"
+#include "array2_file.hpp"
+#include "options.hpp"
+#include "benchmark.hpp"
+#include "report.hpp"
+#include "thread_pool.hpp"
+#include "perf_counters.hpp"
+#include "allocations.hpp"
+#include "arena.hpp"
+#include "task_scheduler.hpp"
+#include "result_cache.hpp"
+#include "batch.hpp"
+#include "prefetch.hpp"
+#include "trace.hpp"
+#include "profiler.hpp"
+
+// Version of the solvers of a day, part of the result cache key. Every day passes it to register_puzzle from its own source file.
+// The CMake build defines it per day as a hash of that file and of the harness, see cmake/solver_version.cmake, so editing
+// one day invalidates only its cached results. Other builds fall back to the time the day's file was compiled.
+#if !defined(AOC_SOLVER_VERSION)
+#define AOC_SOLVER_VERSION __DATE__ " " __TIME__
+#endif
 
 namespace aoc
 {
 
-    struct puzzle_exception : public std::exception
+    struct puzzle_exception : public std::runtime_error
     {
         puzzle_exception(const std::string& message) :
-            std::exception(message.c_str())
+            std::runtime_error(message)
         {}
     };
 
-    std::string time_to_string(std::chrono::nanoseconds microseconds)
+    inline std::string time_to_string(std::chrono::nanoseconds microseconds)
     {
         const auto ticks = microseconds.count();
 
@@ -40,46 +76,121 @@ namespace aoc
         return std::to_string(static_cast<double>(ticks) / 1000'000'000.0) + " seconds";
     }
 
+    template<typename T>
+    std::string result_to_string(const T& result)
+    {
+        std::stringstream ss;
+        ss << result;
+        return ss.str();
+    }
+
+
+    struct input_format
+    {
+        bool skip_empty_lines = false;
+        bool split_words = false;
+    };
 
     template<typename TDataType>
     struct input_data
     {
         std::vector<TDataType> data;
         size_t day;
+        std::shared_ptr<const mapped_file> mapping = nullptr; // Owns the memory of std::string_view input.
+        std::chrono::nanoseconds read_time = {};
+        std::shared_ptr<const std::string> text = nullptr; // Owns the memory of std::string_view input read from memory.
     };
 
 
-    template<size_t VDay, typename TDataType>
-    input_data<TDataType> read_input(const bool skip_empty_lines = false, const bool split_words = false)
+    inline std::string get_input_filename(const size_t day)
+    {
+        const auto& options = get_options();
+        if (!options.input_filename.empty())
+        {
+            return options.input_filename;
+        }
+
+        const auto directory = options.input_directory.empty() ? std::string("../inputs") : options.input_directory;
+        return directory + "/day_" + std::to_string(day) + "_input.txt";
+    }
+
+    // Binary grid input of a day, written by convert_grid next to the text input.
+    inline std::string get_binary_input_filename(const size_t day)
+    {
+        const auto& options = get_options();
+        if (!options.input_filename.empty())
+        {
+            return options.input_filename;
+        }
+
+        const auto directory = options.input_directory.empty() ? std::string("../inputs") : options.input_directory;
+        return directory + "/day_" + std::to_string(day) + "_input.bin";
+    }
+
+    inline std::vector<std::string_view> split_input_lines(const std::string_view text, const input_format format)
+    {
+        std::vector<std::string_view> data;
+
+        auto add_line = [&](std::string_view line)
+        {
+            if (line.empty() && format.skip_empty_lines)
+            {
+                return;
+            }
+
+            data.push_back(line);
+        };
+
+        if (format.split_words)
+        {
+            for_each_word(text, add_line);
+        }
+        else
+        {
+            for_each_line(text, add_line);
+        }
+
+        return data;
+    }
+
+    inline input_data<std::string_view> read_mapped_input(const std::string& filename, const size_t day, const input_format format)
     {
-        const std::string filename = "../inputs/day_" + std::to_string(VDay) + "_input.txt";
-             
+        AOC_TRACE_SCOPE("read_input");
         auto start_time = std::chrono::high_resolution_clock::now();
-        
-        std::ifstream file(filename);
-        if (!file.is_open())
+
+        auto mapping = std::make_shared<mapped_file>();
+        if (!mapping->open(filename))
         {
-            std::cerr << "read_input: Failed to open input file: " << filename << "\n";
+            std::cerr << "read_input: Failed to map input file: " << filename << "\n";
             return {};
         }
 
-        std::vector<TDataType> data;
+        auto data = split_input_lines(mapping->view(), format);
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+        return { std::move(data), day, std::move(mapping), duration };
+    }
 
-        
-        while (!file.eof())
+    // Reads every line or word of the stream as a TDataType. Returns false if a value fails to convert.
+    template<typename TDataType>
+    bool read_stream_values(std::istream& stream, const input_format format, std::vector<TDataType>& data)
+    {
+        while (!stream.eof())
         {
             std::string line;
 
-            if (split_words)
+            if (format.split_words)
             {
-                file >> line;
+                stream >> line;
             }
             else
             {
-                std::getline(file, line);
+                std::getline(stream, line);
             }
-            
-            if (line.empty() && skip_empty_lines)
+
+            if (line.empty() && format.skip_empty_lines)
             {
                 continue;
             }
@@ -95,57 +206,1467 @@ namespace aoc
                 if (result.ec != std::errc())
                 {
                     std::cerr << "read_input: Failed to convert input value: " << line << "\n";
-                    return {};
+                    return false;
                 }
 
                 data.push_back(value);
             }
         }
 
+        return true;
+    }
+
+    // Reads every line or word of text as one integer with the vectorised tokenizer. Returns false if a value fails to convert.
+    template<typename TDataType>
+    bool read_integer_values(const std::string_view text, const input_format format, std::vector<TDataType>& data)
+    {
+        bool success = true;
+        auto add_value = [&](const std::string_view token)
+        {
+            if (!success || (token.empty() && format.skip_empty_lines))
+            {
+                return;
+            }
+
+            int64_t value = 0;
+            if (!parse_integer(token, value) || !std::in_range<TDataType>(value))
+            {
+                std::cerr << "read_input: Failed to convert input value: " << token << "\n";
+                success = false;
+                return;
+            }
+            data.push_back(static_cast<TDataType>(value));
+        };
+
+        if (format.split_words)
+        {
+            for_each_word(text, add_value);
+        }
+        else
+        {
+            for_each_line(text, add_value);
+        }
+
+        return success;
+    }
+
+    template<typename TDataType>
+    input_data<TDataType> read_mapped_integers(const std::string& filename, const size_t day, const input_format format)
+    {
+        AOC_TRACE_SCOPE("read_input");
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        mapped_file file;
+        if (!file.open(filename))
+        {
+            std::cerr << "read_input: Failed to map input file: " << filename << "\n";
+            return {};
+        }
+
+        std::vector<TDataType> data;
+        if (!read_integer_values(file.view(), format, data))
+        {
+            return {};
+        }
+
         auto end_time = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
-        std::string convert_text = std::is_same_v<TDataType, std::string> == false ? " (and converting)" : "";
-        std::cout << "Reading" + convert_text + " input file took " << time_to_string(duration) << "\n";
 
-        return { std::move(data), VDay};
+        return { std::move(data), day, nullptr, duration };
     }
 
+    template<typename TDataType>
+    input_data<TDataType> read_stream_input(const std::string& filename, const size_t day, const input_format format)
+    {
+        AOC_TRACE_SCOPE("read_input");
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        std::ifstream file(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "read_input: Failed to open input file: " << filename << "\n";
+            return {};
+        }
+
+        std::vector<TDataType> data;
+        if (!read_stream_values(file, format, data))
+        {
+            return {};
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+        return { std::move(data), day, nullptr, duration };
+    }
 
-    template<typename TInputDataType, typename ... TSolvers>
-    void solve_puzzles(const input_data<TInputDataType>& input, TSolvers ... solvers)
+    // Reads input held in memory instead of a file, such as input sent to aoc_daemon. std::string_view data refers to `text`, which is kept alive.
+    template<typename TDataType>
+    input_data<TDataType> read_text_input(std::shared_ptr<const std::string> text, const size_t day, const input_format format = {})
     {
-        size_t part = 0;
+        AOC_TRACE_SCOPE("read_input");
+        auto start_time = std::chrono::high_resolution_clock::now();
 
-        try
+        input_data<TDataType> result{ {}, day };
+        if constexpr (std::is_same_v<TDataType, std::string_view> == true)
+        {
+            result.data = split_input_lines(*text, format);
+        }
+        else if constexpr (std::is_integral_v<TDataType> == true)
+        {
+            if (!read_integer_values(*text, format, result.data))
+            {
+                return {};
+            }
+        }
+        else
         {
-            if (input.data.empty())
+            std::istringstream stream(*text);
+            if (!read_stream_values(stream, format, result.data))
             {
-                throw puzzle_exception("Input data is empty.");
+                return {};
             }
+        }
 
-            std::cout << "Day " << input.day << " results:\n";
-            (solve_puzzle(input, ++part, solvers), ...);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.read_time = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        result.text = std::move(text);
+        return result;
+    }
+
+    // Reading std::string_view memory maps the input file instead of copying every line.
+    // Integers are parsed straight from the mapping by the vectorised tokenizer.
+    template<typename TDataType>
+    input_data<TDataType> read_input(const std::string& filename, const size_t day, const input_format format = {})
+    {
+        if constexpr (std::is_same_v<TDataType, std::string_view> == true)
+        {
+            return read_mapped_input(filename, day, format);
         }
-        catch (puzzle_exception& e)
+        else if constexpr (std::is_integral_v<TDataType> == true)
         {
-            std::cerr << "Failed to solve part " << part << ": " << e.what() << std::endl;
+            return read_mapped_integers<TDataType>(filename, day, format);
         }
-        catch (std::exception& e)
+        else
+        {
+            return read_stream_input<TDataType>(filename, day, format);
+        }
+    }
+
+
+    // Reads a file in fixed-size chunks and hands the complete lines of every chunk to a callback, as batches of views.
+    // Memory use is bounded by the budget, regardless of the file size. Lines longer than the chunk size are an error.
+    class line_stream
+    {
+
+    public:
+
+        line_stream(const std::string& filename, const input_format format, const size_t memory_budget) :
+            m_file(filename, std::ios::binary),
+            m_format(format),
+            m_buffer(std::max<size_t>(memory_budget - (memory_budget / 4), 1)),
+            m_max_batch_size(std::max<size_t>((memory_budget / 4) / sizeof(std::string_view), 1))
+        {
+            if (!m_file.is_open())
+            {
+                throw puzzle_exception("Failed to open input file: " + filename);
+            }
+            m_batch.reserve(m_max_batch_size);
+        }
+
+        // Views passed to the callback are only valid during the call.
+        template<typename TCallback>
+        void for_each_batch(TCallback callback)
+        {
+            AOC_TRACE_SCOPE("stream_input");
+
+            size_t carry_size = 0;
+            bool end_of_file = false;
+
+            while (!end_of_file)
+            {
+                m_file.read(m_buffer.data() + carry_size, static_cast<std::streamsize>(m_buffer.size() - carry_size));
+                const auto read_size = static_cast<size_t>(m_file.gcount());
+                m_bytes_read += read_size;
+                end_of_file = m_file.eof() || read_size == 0;
+
+                const auto chunk = std::string_view(m_buffer.data(), carry_size + read_size);
+                size_t line_start = 0;
+
+                for (auto line_end = chunk.find('\n'); line_end != std::string_view::npos; line_end = chunk.find('\n', line_start))
+                {
+                    add_line(chunk.substr(line_start, line_end - line_start), callback);
+                    line_start = line_end + 1;
+                }
+
+                if (end_of_file && line_start < chunk.size())
+                {
+                    add_line(chunk.substr(line_start), callback);
+                    line_start = chunk.size();
+                }
+
+                flush_batch(callback);
+
+                carry_size = chunk.size() - line_start;
+                if (carry_size == m_buffer.size())
+                {
+                    throw puzzle_exception("Input line exceeds the stream memory budget.");
+                }
+                std::memmove(m_buffer.data(), m_buffer.data() + line_start, carry_size);
+            }
+        }
+
+        template<typename TCallback>
+        void for_each_line(TCallback callback)
+        {
+            for_each_batch([&](std::span<const std::string_view> lines)
+            {
+                for (const auto line : lines)
+                {
+                    callback(line);
+                }
+            });
+        }
+
+        uint64_t get_bytes_read() const
+        {
+            return m_bytes_read;
+        }
+
+    private:
+
+        template<typename TCallback>
+        void add_line(std::string_view line, TCallback& callback)
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            if (line.empty() && m_format.skip_empty_lines)
+            {
+                return;
+            }
+
+            m_batch.push_back(line);
+            if (m_batch.size() == m_max_batch_size)
+            {
+                flush_batch(callback);
+            }
+        }
+
+        template<typename TCallback>
+        void flush_batch(TCallback& callback)
+        {
+            if (!m_batch.empty())
+            {
+                callback(std::span<const std::string_view>(m_batch));
+                m_batch.clear();
+            }
+        }
+
+        std::ifstream m_file;
+        input_format m_format;
+        std::vector<char> m_buffer;
+        std::vector<std::string_view> m_batch;
+        size_t m_max_batch_size;
+        uint64_t m_bytes_read = 0;
+
+    };
+
+
+    // Solvers taking their input by value get a fresh copy on every call, as part of the measured time.
+    template<typename TInputType, typename TSolver>
+    part_report benchmark_puzzle(const TInputType& input, const size_t part, TSolver solver, std::ostream& output)
+    {
+        using TReturnType = std::invoke_result_t<TSolver, const TInputType&>;
+        const auto& options = get_options();
+
+        // Every run gets the same arena, emptied in between. After the warmup it has grown to what a run needs.
+        part_arena arena;
+
+        for (size_t i = 0; i < options.warmup_iterations; i++)
+        {
+            AOC_TRACE_SCOPE("warmup");
+            {
+                memory_resource_scope arena_scope(arena.get_resource());
+                solver(input);
+            }
+            arena.reset();
+        }
+
+        std::vector<std::chrono::nanoseconds> samples;
+        samples.reserve(options.iterations);
+        TReturnType result{};
+
+        std::optional<perf_counters> counters;
+        if (options.perf_counters)
+        {
+            counters.emplace();
+        }
+
+        allocation_tracker allocations;
+
+        for (size_t i = 0; i < options.iterations; i++)
+        {
+            allocations.start();
+            auto start_time = std::chrono::high_resolution_clock::now();
+            {
+                AOC_TRACE_SCOPE("iteration");
+                memory_resource_scope arena_scope(arena.get_resource());
+                if (counters)
+                {
+                    counters->start();
+                }
+                result = solver(input);
+                if (counters)
+                {
+                    counters->stop();
+                }
+            }
+            auto end_time = std::chrono::high_resolution_clock::now();
+            allocations.stop();
+            arena.reset();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time));
+        }
+
+        const auto statistics = calculate_timing_statistics(std::move(samples));
+
+        output << "Part " << part << " result: " << result << "\n";
+        output << "    iterations: " << statistics.iterations << " (+" << options.warmup_iterations << " warmup)\n";
+        output << "    min:    " << time_to_string(statistics.min) << "\n";
+        output << "    median: " << time_to_string(statistics.median) << "\n";
+        output << "    mean:   " << time_to_string(statistics.mean) << "\n";
+        output << "    p90:    " << time_to_string(statistics.p90) << "\n";
+        output << "    p99:    " << time_to_string(statistics.p99) << "\n";
+        output << "    stddev: " << time_to_string(statistics.standard_deviation) << "\n";
+
+        part_report report;
+        report.part = part;
+        report.result = result_to_string(result);
+        report.timing = statistics;
+        if (counters)
         {
-            std::cerr << "Internal error on " << part << ": " << e.what() << std::endl;
+            const auto uncounted_workers = get_parallel_thread_count() - 1;
+            print_perf_counters(output, *counters, options.iterations, uncounted_workers);
+            report.counters = counters->read().divided_by(options.iterations);
+            report.counters->uncounted_workers = uncounted_workers;
         }
+        if constexpr (is_tracking_allocations())
+        {
+            report.allocations = divide_allocation_statistics(allocations.get_statistics(), options.iterations);
+            print_allocation_statistics(output, *report.allocations);
+        }
+        return report;
     }
 
-    template<typename TReturnType, typename TDataType>
-    void solve_puzzle(const input_data<TDataType>& input, const size_t part, TReturnType(*solver)(const std::vector<TDataType>&))
+    template<typename TInputType, typename TSolver>
+    part_report solve_puzzle(const TInputType& input, const size_t part, TSolver solver, std::ostream& output)
     {
+        if (get_options().benchmark)
+        {
+            return benchmark_puzzle(input, part, solver, output);
+        }
+
+        std::optional<perf_counters> counters;
+        if (get_options().perf_counters)
+        {
+            counters.emplace();
+        }
+
+        part_arena arena;
+        allocation_tracker allocations;
+        allocations.start();
         auto start_time = std::chrono::high_resolution_clock::now();
-        auto result = solver(input.data);
+        auto result = [&]()
+        {
+            AOC_TRACE_SCOPE("solve");
+            memory_resource_scope arena_scope(arena.get_resource());
+            if (counters)
+            {
+                counters->start();
+            }
+            auto part_result = solver(input);
+            if (counters)
+            {
+                counters->stop();
+            }
+            return part_result;
+        }();
         auto end_time = std::chrono::high_resolution_clock::now();
+        allocations.stop();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
 
-        std::cout << "Part " << part << " result: " << result << "    time: " << time_to_string(duration) << "\n";
-    }   
+        output << "Part " << part << " result: " << result << "    time: " << time_to_string(duration) << "\n";
+
+        part_report report;
+        report.part = part;
+        report.result = result_to_string(result);
+        report.timing = make_single_timing(duration);
+        if (counters)
+        {
+            const auto uncounted_workers = get_parallel_thread_count() - 1;
+            print_perf_counters(output, *counters, 1, uncounted_workers);
+            report.counters = counters->read();
+            report.counters->uncounted_workers = uncounted_workers;
+        }
+        if constexpr (is_tracking_allocations())
+        {
+            report.allocations = allocations.get_statistics();
+            print_allocation_statistics(output, *report.allocations);
+        }
+        return report;
+    }
+
+
+    // Type erased input of a registered puzzle, shared by all of its parts.
+    struct puzzle_input
+    {
+        size_t day = 0;
+        std::shared_ptr<const void> data;
+        bool is_empty = true;
+        std::chrono::nanoseconds read_time = {};
+        std::optional<std::chrono::nanoseconds> parse_time; // Set for puzzles registered with a parser stage.
+        std::string error;
+        bool is_streamed = false; // Every part streams the input file itself, nothing was read up front.
+        bool is_cached = false; // The results come from the result cache, nothing was read. read_time is the time of the lookup.
+
+        bool is_valid() const
+        {
+            return !is_empty && error.empty();
+        }
+    };
+
+    inline puzzle_input make_puzzle_input(const size_t day, std::shared_ptr<const void> data, const bool is_empty, const std::chrono::nanoseconds read_time = {})
+    {
+        puzzle_input input;
+        input.day = day;
+        input.data = std::move(data);
+        input.is_empty = is_empty;
+        input.read_time = read_time;
+        return input;
+    }
+
+    struct part_output
+    {
+        size_t part = 0;
+        bool success = false;
+        std::string text;
+        std::string error;
+        part_report report;
+        std::chrono::nanoseconds duration = {};
+    };
+
+    struct registered_puzzle
+    {
+        size_t day = 0;
+        std::function<puzzle_input(const std::string&)> read;
+        std::vector<std::function<part_output(const puzzle_input&)>> parts;
+        std::vector<std::function<part_output(const std::string&)>> streaming_parts; // Indexed like parts, empty if a part has no streaming variant.
+        std::function<puzzle_input(const std::string&)> read_binary; // Loads a binary grid file instead, with --binary. Empty if unsupported.
+        std::function<puzzle_input(std::shared_ptr<const std::string>)> read_text; // Reads input held in memory instead of a file.
+        std::string version; // AOC_SOLVER_VERSION of the day's source file.
+    };
+
+    inline std::vector<registered_puzzle>& get_puzzle_registry()
+    {
+        static std::vector<registered_puzzle> registry;
+        return registry;
+    }
+
+    template<typename TInputType, typename TSolver>
+    part_output solve_part(const size_t day, const TInputType& input, const size_t part, TSolver solver)
+    {
+        part_output output;
+        output.part = part;
+        set_trace_context(day, part);
+
+        std::stringstream text;
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        try
+        {
+            part_profiler profiler(day, part);
+            output.report = solve_puzzle(input, part, solver, text);
+            profiler.finish(text);
+            output.success = true;
+        }
+        catch (puzzle_exception& e)
+        {
+            output.error = "Failed to solve part " + std::to_string(part) + ": " + e.what();
+        }
+        catch (std::exception& e)
+        {
+            output.error = "Internal error on " + std::to_string(part) + ": " + e.what();
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        output.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+        output.text = text.str();
+        return output;
+    }
+
+    // Adds a puzzle to the registry, run by run_puzzles(). Meant to initialize a namespace scope constant in every day,
+    // with AOC_SOLVER_VERSION as the version so it expands in the day's own file.
+    template<size_t VDay, typename TDataType, typename ... TSolvers>
+    bool register_puzzle(const std::string& version, const input_format format, TSolvers ... solvers)
+    {
+        registered_puzzle puzzle;
+        puzzle.day = VDay;
+        puzzle.version = version;
+        auto make_input = [](input_data<TDataType>&& raw_input)
+        {
+            auto input = std::make_shared<input_data<TDataType>>(std::move(raw_input));
+            return make_puzzle_input(VDay, input, input->data.empty(), input->read_time);
+        };
+        puzzle.read = [format, make_input](const std::string& filename)
+        {
+            set_trace_context(VDay, 0);
+            return make_input(read_input<TDataType>(filename, VDay, format));
+        };
+        puzzle.read_text = [format, make_input](std::shared_ptr<const std::string> text)
+        {
+            set_trace_context(VDay, 0);
+            return make_input(read_text_input<TDataType>(std::move(text), VDay, format));
+        };
+
+        size_t part = 0;
+        auto add_part = [&](auto solver)
+        {
+            puzzle.parts.push_back([solver, part = ++part](const puzzle_input& input)
+            {
+                const auto& data = *std::static_pointer_cast<const input_data<TDataType>>(input.data);
+                return solve_part(VDay, data.data, part, solver);
+            });
+        };
+        (add_part(solvers), ...);
+
+        get_puzzle_registry().push_back(std::move(puzzle));
+        return true;
+    }
+
+    // Runs a streaming solver over the input file and prints its throughput.
+    template<typename TSolver>
+    part_output solve_streaming_part(const size_t day, const std::string& filename, const input_format format, const size_t part, TSolver solver)
+    {
+        auto stream_solver = [format, solver](const std::string& input_filename)
+        {
+            line_stream stream(input_filename, format, get_options().stream_budget);
+            return solver(stream);
+        };
+
+        auto output = solve_part(day, filename, part, stream_solver);
+        if (output.success)
+        {
+            std::error_code error;
+            const auto file_size = std::filesystem::file_size(filename, error);
+            const auto seconds = std::chrono::duration<double>(output.report.timing.median).count();
+            if (!error && seconds > 0.0)
+            {
+                std::stringstream text;
+                text << "    throughput: " << (static_cast<double>(file_size) / 1000'000.0) / seconds << " MB/s\n";
+                output.text += text.str();
+            }
+        }
+        return output;
+    }
+
+    // Adds streaming variants of the first parts of an already registered puzzle, used instead of them with --stream.
+    // Solvers take an aoc::line_stream& and must be registered in the same file, after register_puzzle.
+    template<size_t VDay, typename ... TSolvers>
+    bool register_streaming_parts(const input_format format, TSolvers ... solvers)
+    {
+        auto& registry = get_puzzle_registry();
+        auto it = std::find_if(registry.begin(), registry.end(), [](const auto& puzzle) { return puzzle.day == VDay; });
+        if (it == registry.end())
+        {
+            std::cerr << "register_streaming_parts: Day " << VDay << " is not registered.\n";
+            return false;
+        }
+
+        size_t part = 0;
+        auto add_part = [&](auto solver)
+        {
+            it->streaming_parts.push_back([format, solver, part = ++part](const std::string& filename)
+            {
+                return solve_streaming_part(VDay, filename, format, part, solver);
+            });
+        };
+        (add_part(solvers), ...);
+
+        return true;
+    }
+
+    template<typename TDataType, typename TParsedType>
+    struct parsed_input_data
+    {
+        template<typename TParser>
+        parsed_input_data(input_data<TDataType>&& raw_input, TParser parser) :
+            input(std::move(raw_input)),
+            parsed(parser(input.data))
+        {}
+
+        explicit parsed_input_data(TParsedType&& parsed_data) :
+            input{},
+            parsed(std::move(parsed_data))
+        {}
+
+        input_data<TDataType> input; // Kept alive, the parsed data may refer to the mapped input.
+        TParsedType parsed;
+    };
+
+    // Like register_puzzle, but the input is parsed once by the parser and the parts receive the parsed data.
+    // Parts take it by const reference, or by value if they need a copy to modify.
+    template<size_t VDay, typename TDataType, typename TParsedType, typename ... TSolvers>
+    bool register_parsed_puzzle(const std::string& version, const input_format format, TParsedType(*parser)(const std::vector<TDataType>&), TSolvers ... solvers)
+    {
+        using parsed_type = parsed_input_data<TDataType, TParsedType>;
+
+        registered_puzzle puzzle;
+        puzzle.day = VDay;
+        puzzle.version = version;
+        auto make_input = [parser](input_data<TDataType>&& raw_input)
+        {
+            auto input = make_puzzle_input(VDay, nullptr, raw_input.data.empty(), raw_input.read_time);
+            if (input.is_empty)
+            {
+                return input;
+            }
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+            try
+            {
+                AOC_TRACE_SCOPE("parse");
+                input.data = std::make_shared<const parsed_type>(std::move(raw_input), parser);
+            }
+            catch (puzzle_exception& e)
+            {
+                input.error = std::string("Failed to parse input: ") + e.what();
+            }
+            catch (std::exception& e)
+            {
+                input.error = std::string("Internal error on parsing input: ") + e.what();
+            }
+            auto end_time = std::chrono::high_resolution_clock::now();
+            input.parse_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+
+            return input;
+        };
+        puzzle.read = [format, make_input](const std::string& filename)
+        {
+            set_trace_context(VDay, 0);
+            return make_input(read_input<TDataType>(filename, VDay, format));
+        };
+        puzzle.read_text = [format, make_input](std::shared_ptr<const std::string> text)
+        {
+            set_trace_context(VDay, 0);
+            return make_input(read_text_input<TDataType>(std::move(text), VDay, format));
+        };
+
+        size_t part = 0;
+        auto add_part = [&](auto solver)
+        {
+            puzzle.parts.push_back([solver, part = ++part](const puzzle_input& input)
+            {
+                const auto& data = *std::static_pointer_cast<const parsed_type>(input.data);
+                return solve_part(VDay, data.parsed, part, solver);
+            });
+        };
+        (add_part(solvers), ...);
+
+        get_puzzle_registry().push_back(std::move(puzzle));
+        return true;
+    }
+
+    // Lets a puzzle registered with register_parsed_puzzle load its parsed data from a binary Array2 file, see array2_file.hpp.
+    // With --binary the file is memory mapped, which is the read stage, and handed to the loader as a view, which is the parse stage.
+    template<size_t VDay, typename TDataType, typename TParsedType, typename TElement>
+    bool register_binary_input(TParsedType(*loader)(const Array2View<const TElement>&))
+    {
+        using parsed_type = parsed_input_data<TDataType, TParsedType>;
+
+        auto& registry = get_puzzle_registry();
+        auto it = std::find_if(registry.begin(), registry.end(), [](const auto& puzzle) { return puzzle.day == VDay; });
+        if (it == registry.end())
+        {
+            std::cerr << "register_binary_input: Day " << VDay << " is not registered.\n";
+            return false;
+        }
+
+        it->read_binary = [loader](const std::string& filename)
+        {
+            set_trace_context(VDay, 0);
+            auto input = make_puzzle_input(VDay, nullptr, true);
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+            mapped_array2<TElement> file;
+            {
+                AOC_TRACE_SCOPE("read_input");
+                if (!file.open(filename))
+                {
+                    return input;
+                }
+            }
+            auto parse_start_time = std::chrono::high_resolution_clock::now();
+            input.read_time = std::chrono::duration_cast<std::chrono::nanoseconds>(parse_start_time - start_time);
+            input.is_empty = file.get_header().width == 0 || file.get_header().height == 0;
+
+            if (!file.is_row_major())
+            {
+                input.error = "Failed to parse input: Binary input must have the row-major layout.";
+                return input;
+            }
+
+            try
+            {
+                AOC_TRACE_SCOPE("parse");
+                input.data = std::make_shared<const parsed_type>(loader(file.view()));
+            }
+            catch (puzzle_exception& e)
+            {
+                input.error = std::string("Failed to parse input: ") + e.what();
+            }
+            catch (std::exception& e)
+            {
+                input.error = std::string("Internal error on parsing input: ") + e.what();
+            }
+            auto end_time = std::chrono::high_resolution_clock::now();
+            input.parse_time = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - parse_start_time);
+
+            return input;
+        };
+
+        return true;
+    }
+
+
+    // Exports and compares the timings of finished runs, as requested by the options. Returns false on failure.
+    inline bool process_reports(const std::vector<puzzle_report>& reports)
+    {
+        const auto& options = get_options();
+        bool success = true;
+
+        if (!options.export_filename.empty())
+        {
+            success = write_report(options.export_filename, reports) && success;
+        }
+
+        if (!options.baseline_filename.empty())
+        {
+            baseline_timings baseline;
+            if (read_baseline(options.baseline_filename, baseline))
+            {
+                for (const auto& report : reports)
+                {
+                    success = compare_to_baseline(report, baseline, options.regression_threshold) && success;
+                }
+            }
+            else
+            {
+                success = false;
+            }
+        }
+
+        return success;
+    }
+
+    inline bool is_streaming_part(const registered_puzzle& puzzle, const size_t part_index)
+    {
+        return get_options().stream && part_index < puzzle.streaming_parts.size() && puzzle.streaming_parts[part_index];
+    }
+
+    inline bool is_binary_input(const registered_puzzle& puzzle)
+    {
+        return get_options().binary_input && puzzle.read_binary;
+    }
+
+    inline std::string get_puzzle_input_filename(const registered_puzzle& puzzle)
+    {
+        return is_binary_input(puzzle) ? get_binary_input_filename(puzzle.day) : get_input_filename(puzzle.day);
+    }
+
+    // Reads the input, unless every part is going to stream it.
+    inline puzzle_input read_puzzle_input(const registered_puzzle& puzzle)
+    {
+        for (size_t i = 0; i < puzzle.parts.size(); i++)
+        {
+            if (!is_streaming_part(puzzle, i))
+            {
+                if (is_binary_input(puzzle))
+                {
+                    return puzzle.read_binary(get_puzzle_input_filename(puzzle));
+                }
+                return puzzle.read(get_puzzle_input_filename(puzzle));
+            }
+        }
+
+        auto input = make_puzzle_input(puzzle.day, nullptr, false);
+        input.is_streamed = true;
+        return input;
+    }
+
+    inline part_output run_part(const registered_puzzle& puzzle, const size_t part_index, const puzzle_input& input)
+    {
+        if (is_streaming_part(puzzle, part_index))
+        {
+            return puzzle.streaming_parts[part_index](get_input_filename(puzzle.day));
+        }
+        return puzzle.parts[part_index](input);
+    }
+
+    struct puzzle_result
+    {
+        size_t day = 0;
+        puzzle_input input;
+        std::vector<part_output> parts;
+        std::chrono::nanoseconds finish_time = {}; // Relative to the start of the run.
+        std::optional<result_cache_key> cache_key; // Set if the result cache is used for this run.
+        std::string cache_error; // Cached results that differ from the computed ones, with --verify-cache.
+
+        bool succeeded() const
+        {
+            return input.is_valid() && cache_error.empty() && std::all_of(parts.begin(), parts.end(), [](const auto& part) { return part.success; });
+        }
+
+        // Reading and parsing the input, followed by the slowest part.
+        std::chrono::nanoseconds get_critical_path() const
+        {
+            std::chrono::nanoseconds slowest_part = {};
+            for (const auto& part : parts)
+            {
+                slowest_part = std::max(slowest_part, part.duration);
+            }
+            return input.read_time + input.parse_time.value_or(std::chrono::nanoseconds{ 0 }) + slowest_part;
+        }
+
+        puzzle_report get_report() const
+        {
+            puzzle_report report{ day, input.read_time, input.parse_time, {} };
+            for (const auto& part : parts)
+            {
+                if (part.success)
+                {
+                    report.parts.push_back(part.report);
+                }
+            }
+            return report;
+        }
+    };
+
+    // Measuring runs always solve, they are not served from or written to the result cache. That includes exported
+    // and baseline runs, whose timings must come from this run.
+    inline bool is_result_cache_enabled()
+    {
+        const auto& options = get_options();
+        return (options.use_cache || options.verify_cache) && !options.benchmark && !options.perf_counters && !options.stream &&
+            options.trace_filename.empty() && options.profile_directory.empty() && options.batch_path.empty() &&
+            options.export_filename.empty() && options.baseline_filename.empty();
+    }
+
+    // Hashes the input of the puzzle and looks up its results. Returns true on a hit, the puzzle need not be read or solved then.
+    inline bool lookup_cached_puzzle(const registered_puzzle& puzzle, puzzle_result& result)
+    {
+        if (!is_result_cache_enabled())
+        {
+            return false;
+        }
+
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        result_cache_key key;
+        if (!make_result_cache_key(puzzle.day, puzzle.version, get_puzzle_input_filename(puzzle), key))
+        {
+            return false;
+        }
+        result.cache_key = key;
+
+        std::vector<cached_part> cached_parts;
+        if (get_options().verify_cache || !read_result_cache(get_options().cache_directory, key, cached_parts) ||
+            cached_parts.size() != puzzle.parts.size())
+        {
+            return false;
+        }
+
+        result.input = make_puzzle_input(puzzle.day, nullptr, false);
+        result.input.is_cached = true;
+        result.parts.clear();
+        for (auto& cached : cached_parts)
+        {
+            part_output output;
+            output.part = cached.report.part;
+            output.success = true;
+            output.text = std::move(cached.text);
+            output.report = std::move(cached.report);
+            result.parts.push_back(std::move(output));
+        }
+        result.input.read_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_time);
+        return true;
+    }
+
+    // Stores the results of a solved puzzle. With --verify-cache, compares them to the previous entry first and replaces it either way.
+    inline void update_result_cache(puzzle_result& result)
+    {
+        if (!result.cache_key || !result.succeeded() || result.input.is_cached)
+        {
+            return;
+        }
+
+        const auto& options = get_options();
+        std::vector<cached_part> cached_parts;
+        if (options.verify_cache && read_result_cache(options.cache_directory, *result.cache_key, cached_parts))
+        {
+            for (size_t i = 0; i < result.parts.size(); i++)
+            {
+                const auto& computed = result.parts[i].report.result;
+                if (i >= cached_parts.size() || cached_parts[i].report.result != computed)
+                {
+                    const auto cached = i < cached_parts.size() ? cached_parts[i].report.result : std::string("<missing>");
+                    result.cache_error += "Cached result of day " + std::to_string(result.day) + " part " + std::to_string(i + 1) +
+                        " differs: cached " + cached + ", computed " + computed + ".\n";
+                }
+            }
+            if (!result.cache_error.empty())
+            {
+                std::cerr << result.cache_error << std::flush;
+            }
+        }
+
+        cached_parts.clear();
+        for (const auto& part : result.parts)
+        {
+            cached_parts.push_back({ part.text, part.report });
+        }
+        write_result_cache(options.cache_directory, *result.cache_key, cached_parts);
+    }
+
+    inline void print_input_result(const puzzle_input& input)
+    {
+        if (input.is_empty)
+        {
+            std::cerr << "Failed to solve day " << input.day << ": Input data is empty." << std::endl;
+            return;
+        }
+
+        if (input.is_cached)
+        {
+            std::cout << "Results of an unchanged input from the cache, lookup took " << time_to_string(input.read_time) << "\n";
+        }
+        else if (input.is_streamed)
+        {
+            std::cout << "Streaming input file\n";
+        }
+        else
+        {
+            std::cout << "Reading input file took " << time_to_string(input.read_time) << "\n";
+        }
+        if (!input.error.empty())
+        {
+            std::cerr << "Failed to solve day " << input.day << ": " << input.error << std::endl;
+            return;
+        }
+        if (input.parse_time)
+        {
+            std::cout << "Parsing input took " << time_to_string(*input.parse_time) << "\n";
+        }
+        std::cout << "Day " << input.day << " results:\n";
+    }
+
+    inline void print_part_result(const part_output& output)
+    {
+        std::cout << output.text;
+        if (!output.success)
+        {
+            std::cerr << output.error << std::endl;
+        }
+    }
+
+    // Runs the parts in order on the calling thread, printing every result as soon as it is available.
+    inline puzzle_result run_puzzle(const registered_puzzle& puzzle)
+    {
+        puzzle_result result;
+        result.day = puzzle.day;
+        if (lookup_cached_puzzle(puzzle, result))
+        {
+            print_input_result(result.input);
+            for (const auto& part : result.parts)
+            {
+                print_part_result(part);
+            }
+            return result;
+        }
+
+        result.input = read_puzzle_input(puzzle);
+        print_input_result(result.input);
+
+        if (!result.input.is_valid())
+        {
+            return result;
+        }
+
+        for (size_t i = 0; i < puzzle.parts.size(); i++)
+        {
+            result.parts.push_back(run_part(puzzle, i, result.input));
+            print_part_result(result.parts.back());
+        }
+
+        update_result_cache(result);
+        return result;
+    }
+
+    inline void print_critical_path_report(const std::vector<puzzle_result>& results, const std::chrono::nanoseconds wall_time, const size_t worker_count)
+    {
+        std::chrono::nanoseconds total_work = {};
+        const puzzle_result* critical_result = nullptr;
+
+        std::cout << "\nCritical paths:\n";
+        for (const auto& result : results)
+        {
+            std::cout << "Day " << result.day << ": " << time_to_string(result.get_critical_path()) <<
+                " (read " << time_to_string(result.input.read_time);
+            if (result.input.parse_time)
+            {
+                std::cout << ", parse " << time_to_string(*result.input.parse_time);
+                total_work += *result.input.parse_time;
+            }
+            for (const auto& part : result.parts)
+            {
+                std::cout << ", part " << part.part << " " << time_to_string(part.duration);
+                total_work += part.duration;
+            }
+            std::cout << "), finished after " << time_to_string(result.finish_time) << "\n";
+
+            total_work += result.input.read_time;
+            if (critical_result == nullptr || result.get_critical_path() > critical_result->get_critical_path())
+            {
+                critical_result = &result;
+            }
+        }
+
+        std::cout << "\nWorkers: " << worker_count << "\n";
+        std::cout << "Total work: " << time_to_string(total_work) << "\n";
+        std::cout << "Total wall-clock time: " << time_to_string(wall_time) << "\n";
+        if (critical_result != nullptr)
+        {
+            std::cout << "Longest critical path: day " << critical_result->day << ", " << time_to_string(critical_result->get_critical_path()) << "\n";
+        }
+    }
+
+    inline void print_prefetch_report(const prefetch_statistics& statistics)
+    {
+        std::cout << "Prefetch: " << statistics.inputs << " inputs read in " << time_to_string(statistics.prepare_time) <<
+            ", reader waited " << time_to_string(statistics.full_time) << " on a full queue, workers waited " <<
+            time_to_string(statistics.empty_time) << " for inputs\n";
+    }
+
+    // Runs every day and part as a separate task on a thread pool. Output is buffered and printed in day order.
+    // With --prefetch, a background thread looks up the cached results or reads the input of every day in order, and the workers only solve.
+    inline std::vector<puzzle_result> run_puzzles_concurrently(const std::vector<registered_puzzle>& puzzles)
+    {
+        const auto& options = get_options();
+        const auto worker_count = options.worker_count == 0 ? get_default_worker_count() : options.worker_count;
+
+        struct puzzle_state
+        {
+            puzzle_result result;
+            size_t parts_left = 0;
+            bool done = false;
+        };
+
+        std::vector<puzzle_state> states(puzzles.size());
+        std::mutex mutex;
+        std::condition_variable condition;
+
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        auto time_since_start = [start_time]()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_time);
+        };
+
+        auto finish_state = [&](puzzle_state& state)
+        {
+            {
+                std::lock_guard lock(mutex);
+                state.result.finish_time = time_since_start();
+                state.done = true;
+            }
+            condition.notify_all();
+        };
+
+        for (size_t i = 0; i < puzzles.size(); i++)
+        {
+            states[i].result.day = puzzles[i].day;
+            states[i].result.parts.resize(puzzles[i].parts.size());
+            states[i].parts_left = puzzles[i].parts.size();
+        }
+
+        std::optional<input_prefetcher<puzzle_result>> prefetcher;
+        if (options.prefetch)
+        {
+            prefetcher.emplace(puzzles.size(), options.read_ahead == 0 ? worker_count : options.read_ahead, [&](const size_t i)
+            {
+                puzzle_result result;
+                result.day = puzzles[i].day;
+                result.parts.resize(puzzles[i].parts.size());
+                if (!lookup_cached_puzzle(puzzles[i], result))
+                {
+                    result.input = read_puzzle_input(puzzles[i]);
+                }
+                return result;
+            });
+        }
+
+        std::function<void(size_t)> start_parts;
+        {
+            thread_pool pool(worker_count, options.pin_workers);
+
+            // Finishes a puzzle served from the cache or with an invalid input, or solves its parts as one task each.
+            start_parts = [&](const size_t i)
+            {
+                const auto& puzzle = puzzles[i];
+                auto& state = states[i];
+
+                if (state.result.input.is_cached)
+                {
+                    finish_state(state);
+                    return;
+                }
+                if (!state.result.input.is_valid() || puzzle.parts.empty())
+                {
+                    state.result.parts.clear();
+                    finish_state(state);
+                    return;
+                }
+
+                for (size_t part_index = 0; part_index < puzzle.parts.size(); part_index++)
+                {
+                    pool.push([&, i, part_index]()
+                    {
+                        auto& state = states[i];
+                        state.result.parts[part_index] = run_part(puzzles[i], part_index, state.result.input);
+
+                        bool is_last_part = false;
+                        {
+                            std::lock_guard lock(mutex);
+                            is_last_part = --state.parts_left == 0;
+                        }
+                        if (is_last_part)
+                        {
+                            update_result_cache(state.result);
+                            finish_state(state);
+                        }
+                    });
+                }
+            };
+
+            for (size_t i = 0; i < puzzles.size(); i++)
+            {
+                pool.push([&, i]()
+                {
+                    if (prefetcher)
+                    {
+                        // Inputs arrive in day order, not necessarily the day of this task.
+                        size_t index = 0;
+                        puzzle_result prepared;
+                        if (prefetcher->take(index, prepared))
+                        {
+                            states[index].result = std::move(prepared);
+                            start_parts(index);
+                        }
+                        return;
+                    }
+
+                    auto& state = states[i];
+                    if (!lookup_cached_puzzle(puzzles[i], state.result))
+                    {
+                        state.result.input = read_puzzle_input(puzzles[i]);
+                    }
+                    start_parts(i);
+                });
+            }
+
+            for (auto& state : states)
+            {
+                {
+                    std::unique_lock lock(mutex);
+                    condition.wait(lock, [&state]() { return state.done; });
+                }
+
+                print_input_result(state.result.input);
+                for (const auto& part : state.result.parts)
+                {
+                    print_part_result(part);
+                }
+            }
+        }
+
+        std::vector<puzzle_result> results;
+        results.reserve(states.size());
+        for (auto& state : states)
+        {
+            results.push_back(std::move(state.result));
+        }
+
+        print_critical_path_report(results, time_since_start(), worker_count);
+        if (prefetcher)
+        {
+            print_prefetch_report(prefetcher->get_statistics());
+        }
+        return results;
+    }
+
+    inline void print_batch_report(const std::vector<puzzle_result>& results, const std::vector<std::chrono::nanoseconds>& latencies,
+        const std::chrono::nanoseconds wall_time, const size_t worker_count)
+    {
+        const auto failures = std::count_if(results.begin(), results.end(), [](const auto& result) { return !result.succeeded(); });
+        const auto seconds = std::chrono::duration<double>(wall_time).count();
+        const auto latency = calculate_timing_statistics(latencies);
+        const auto max_latency = latencies.empty() ? std::chrono::nanoseconds{ 0 } : *std::max_element(latencies.begin(), latencies.end());
+
+        std::cout << "\nBatch of " << results.size() << " inputs, " << failures << " failed\n";
+        std::cout << "Workers: " << worker_count << "\n";
+        std::cout << "Total wall-clock time: " << time_to_string(wall_time) << "\n";
+        if (seconds > 0.0)
+        {
+            std::cout << "Throughput: " << static_cast<double>(results.size()) / seconds << " inputs/s\n";
+        }
+        std::cout << "Latency per input: min " << time_to_string(latency.min) << ", median " << time_to_string(latency.median) <<
+            ", p90 " << time_to_string(latency.p90) << ", p99 " << time_to_string(latency.p99) << ", max " << time_to_string(max_latency) << "\n";
+    }
+
+    // Solves the puzzle for every input of --batch on a pool of --threads workers. Reading an input and solving its parts are separate tasks,
+    // so the next inputs are read while others are solved, and at most --read-ahead inputs wait for a worker, which bounds the memory held by read inputs.
+    // With --prefetch, one background thread reads all inputs in order into a queue of --read-ahead entries instead, and every worker only solves.
+    // Results are printed in input order; the latency of an input runs from the start of its reading to the end of its last part.
+    inline std::vector<puzzle_result> run_puzzle_batch(const registered_puzzle& puzzle)
+    {
+        const auto& options = get_options();
+        const auto worker_count = options.worker_count == 0 ? get_default_worker_count() : options.worker_count;
+        const auto read_ahead = options.read_ahead == 0 ? worker_count : options.read_ahead;
+        const auto max_pending = worker_count + read_ahead;
+
+        std::vector<std::string> filenames;
+        if (!list_batch_inputs(options.batch_path, filenames))
+        {
+            return {};
+        }
+        if (options.evict_inputs)
+        {
+            for (const auto& filename : filenames)
+            {
+                evict_file_cache(filename);
+            }
+        }
+
+        struct input_state
+        {
+            puzzle_result result;
+            std::chrono::high_resolution_clock::time_point start_time;
+            std::chrono::nanoseconds latency = {};
+            bool done = false;
+        };
+
+        struct prefetched_input
+        {
+            puzzle_input input;
+            std::chrono::high_resolution_clock::time_point start_time;
+        };
+
+        std::vector<input_state> states(filenames.size());
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t next_input = 0;
+        size_t pending = 0;
+
+        auto read_batch_input = [&](const size_t i)
+        {
+            return is_binary_input(puzzle) ? puzzle.read_binary(filenames[i]) : puzzle.read(filenames[i]);
+        };
+
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        std::optional<input_prefetcher<prefetched_input>> prefetcher;
+        if (options.prefetch)
+        {
+            prefetcher.emplace(filenames.size(), read_ahead, [&](const size_t i)
+            {
+                const auto read_start_time = std::chrono::high_resolution_clock::now();
+                return prefetched_input{ read_batch_input(i), read_start_time };
+            });
+        }
+
+        std::function<void()> start_inputs;
+        std::function<void(size_t)> solve_input;
+        {
+            thread_pool pool(worker_count, options.pin_workers);
+
+            // Called with the mutex locked, without --prefetch.
+            start_inputs = [&]()
+            {
+                while (next_input < filenames.size() && pending < max_pending)
+                {
+                    const auto i = next_input++;
+                    ++pending;
+
+                    pool.push([&, i]()
+                    {
+                        states[i].start_time = std::chrono::high_resolution_clock::now();
+                        states[i].result.input = read_batch_input(i);
+                        if (!states[i].result.input.is_valid())
+                        {
+                            solve_input(i);
+                            return;
+                        }
+                        pool.push([&, i]() { solve_input(i); });
+                    });
+                }
+            };
+
+            solve_input = [&](const size_t i)
+            {
+                auto& state = states[i];
+                state.result.day = puzzle.day;
+                if (state.result.input.is_valid())
+                {
+                    for (size_t part_index = 0; part_index < puzzle.parts.size(); part_index++)
+                    {
+                        state.result.parts.push_back(run_part(puzzle, part_index, state.result.input));
+                    }
+                }
+
+                {
+                    std::lock_guard lock(mutex);
+                    state.result.finish_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_time);
+                    state.latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - state.start_time);
+                    state.result.input.data.reset();
+                    state.done = true;
+                    if (!prefetcher)
+                    {
+                        --pending;
+                        start_inputs();
+                    }
+                }
+                condition.notify_all();
+            };
+
+            if (prefetcher)
+            {
+                for (size_t worker = 0; worker < worker_count; worker++)
+                {
+                    pool.push([&]()
+                    {
+                        size_t i = 0;
+                        prefetched_input prefetched;
+                        while (prefetcher->take(i, prefetched))
+                        {
+                            states[i].start_time = prefetched.start_time;
+                            states[i].result.input = std::move(prefetched.input);
+                            solve_input(i);
+                        }
+                    });
+                }
+            }
+            else
+            {
+                std::lock_guard lock(mutex);
+                start_inputs();
+            }
+
+            for (size_t i = 0; i < states.size(); i++)
+            {
+                {
+                    std::unique_lock lock(mutex);
+                    condition.wait(lock, [&state = states[i]]() { return state.done; });
+                }
+
+                std::cout << filenames[i] << "\n";
+                print_input_result(states[i].result.input);
+                for (const auto& part : states[i].result.parts)
+                {
+                    print_part_result(part);
+                }
+            }
+        }
+        const auto wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start_time);
+
+        std::vector<puzzle_result> results;
+        std::vector<std::chrono::nanoseconds> latencies;
+        results.reserve(states.size());
+        latencies.reserve(states.size());
+        for (auto& state : states)
+        {
+            results.push_back(std::move(state.result));
+            latencies.push_back(state.latency);
+        }
+
+        print_batch_report(results, latencies, wall_time, worker_count);
+        if (prefetcher)
+        {
+            print_prefetch_report(prefetcher->get_statistics());
+        }
+        return results;
+    }
+
+    // Runs all registered puzzles, concurrently if there are more than one. Returns the exit code of the process.
+    inline int run_puzzles()
+    {
+        const auto& options = get_options();
+        if (!options.trace_filename.empty())
+        {
+            trace_recorder::get().enable();
+        }
+
+        auto puzzles = get_puzzle_registry();
+        std::sort(puzzles.begin(), puzzles.end(), [](const auto& lhs, const auto& rhs) { return lhs.day < rhs.day; });
+
+        if (!options.input_filename.empty() && puzzles.size() != 1)
+        {
+            std::cerr << "run_puzzles: --input requires a single day, use --input-dir instead." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (!options.batch_path.empty() && (puzzles.size() != 1 || !options.input_filename.empty() || options.stream))
+        {
+            std::cerr << "run_puzzles: --batch requires a single day and cannot be combined with --input or --stream." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (options.evict_inputs && options.batch_path.empty())
+        {
+            for (const auto& puzzle : puzzles)
+            {
+                evict_file_cache(get_puzzle_input_filename(puzzle));
+            }
+        }
+
+        std::vector<puzzle_result> results;
+        if (!options.batch_path.empty())
+        {
+            results = run_puzzle_batch(puzzles.front());
+        }
+        else if (puzzles.size() == 1)
+        {
+            results.push_back(run_puzzle(puzzles.front()));
+        }
+        else
+        {
+            results = run_puzzles_concurrently(puzzles);
+        }
+
+        bool success = !results.empty();
+        std::vector<puzzle_report> reports;
+        for (const auto& result : results)
+        {
+            success = result.succeeded() && success;
+            reports.push_back(result.get_report());
+        }
+
+        success = process_reports(reports) && success;
+
+        if (!options.trace_filename.empty())
+        {
+            success = trace_recorder::get().write(options.trace_filename) && success;
+        }
+
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
 }
 
-#endif
\ No newline at end of file
+#endif